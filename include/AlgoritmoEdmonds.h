@@ -2,18 +2,25 @@
 #define ALGORITMOEDMONDS_H
 
 #include "grafoDirecionadoPonderado.h"
+#include "EstatisticasSolver.h"
 #include <vector>
 #include <list>
 
 class AlgoritmoEdmonds {
 public:
-    GrafoDirecionadoPonderado encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz);
+    // Com 'estatisticas' usa a instância que coleta os contadores
+    GrafoDirecionadoPonderado encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz,
+                                                           EstatisticasSolver* estatisticas = nullptr);
 
 private:
 
+    // 'nivel' é a profundidade da recursão; 'aninhamento' guarda, por vértice
+    // representante, o aninhamento do supernó (só usado com estatísticas)
+    template <bool ComEstatisticas>
     std::list<Aresta> edmondsRecursivo(const std::vector<int>& verticesAtuais, 
                                        const std::vector<Aresta>& arestasDisponiveis, 
-                                       int raizAtual);
+                                       int raizAtual, ColetorEstatisticas<ComEstatisticas> coletor,
+                                       int nivel, std::vector<int>& aninhamento);
 };
 
 #endif
\ No newline at end of file
@@ -2,10 +2,36 @@
 #define ALGORITMOGABOW_H
 
 #include "grafoDirecionadoPonderado.h"
+#include "EspacoTrabalhoArborescencia.h"
+#include "PoliticasHeap.h"
+#include "EstatisticasSolver.h"
+#include <vector>
 
+// 'Heap' é uma das políticas de PoliticasHeap.h (instanciadas no .cpp)
 class AlgoritmoGabow {
 public:
+    template <class Heap = HeapSkew>
     GrafoDirecionadoPonderado encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz);
+
+    // Reaproveita a memória de 'espaco' entre chamadas (modo lote). Com
+    // 'estatisticas' usa a instância que coleta os contadores.
+    template <class Heap = HeapSkew>
+    GrafoDirecionadoPonderado encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                                           EstatisticasSolver* estatisticas = nullptr);
+
+    // Versão sem alocação no regime estável: retorna os índices (em getArcos)
+    // das arestas escolhidas, guardados no próprio espaço de trabalho
+    template <class Heap = HeapSkew>
+    const std::vector<int>& encontrarArestasArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco);
+
+    template <class Heap = HeapSkew>
+    const std::vector<int>& encontrarArestasArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                                          EstatisticasSolver& estatisticas);
+
+private:
+    template <class Heap, bool ComEstatisticas>
+    const std::vector<int>& resolver(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                     ColetorEstatisticas<ComEstatisticas> coletor);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -6,4 +6,8 @@ class AlgoritmoKruskal {
 public:
     // Retorna um grafo contendo a MST
     GrafoNaoDirecionadoPonderado encontrarMST(GrafoNaoDirecionadoPonderado& grafo);
+
+    // Sem a ordenação: 'arestasOrdenadas' já em ordem crescente de peso
+    // (partida a quente do modo sequência, que reaproveita a ordem do quadro anterior)
+    GrafoNaoDirecionadoPonderado encontrarMST(int V, const std::vector<Aresta>& arestasOrdenadas);
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef ARQUIVOMAPEADO_H
+#define ARQUIVOMAPEADO_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Arquivo somente leitura mapeado em memória (mmap); fora do POSIX é lido
+// inteiro para um buffer. Lança std::runtime_error se não puder ser aberto.
+class ArquivoMapeado {
+public:
+    explicit ArquivoMapeado(const std::string& caminho);
+    ~ArquivoMapeado();
+
+    ArquivoMapeado(const ArquivoMapeado&) = delete;
+    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+
+    const char* dados() const { return ptr; }
+    size_t tamanho() const { return n; }
+
+private:
+    const char* ptr = nullptr;
+    size_t n = 0;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#endif
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef ARVORECONTRACAO_H
+#define ARVORECONTRACAO_H
+
+#include <vector>
+#include "grafoDirecionadoPonderado.h"
+#include "EspacoTrabalhoArborescencia.h"
+#include "PoliticasHeap.h"
+
+// Árvore de contração completa (sem raiz) no estilo de Gabow.
+// Um vértice artificial 's' ligado a todos os vértices nos dois sentidos
+// (peso maior que a soma dos pesos reais) torna o grafo fortemente conexo,
+// de modo que a contração prossegue até sobrar um único supernó. Depois,
+// a arborescência mínima para qualquer raiz sai em O(V), sem resolver de novo.
+class ArvoreContracao {
+public:
+    // O(E log V); 'Heap' é uma das políticas de PoliticasHeap.h
+    template <class Heap = HeapSkew>
+    void construir(const GrafoDirecionadoPonderado& grafo);
+
+    // Índices (em getArcos) das arestas da arborescência mínima com
+    // raiz 'raiz', em O(V). Se parte do grafo for inalcançável, o resultado é
+    // a floresta geradora mínima em que cada parte extra fica pendurada em 's'
+    // (a raiz de cada parte fica sem aresta).
+    const std::vector<int>& extrair(int raiz);
+
+    int numVertices() const { return n; }
+
+private:
+    int n = 0;                          // Vértices reais; 's' é o vértice n
+    size_t m = 0;                       // Arestas reais; ids >= m são artificiais
+    int numNos = 0;                     // Vértices + supernós (ids em ordem de criação)
+    std::vector<Aresta> arestas;        // Grafo aumentado
+    EspacoTrabalhoArborescencia espaco; // paiNaHierarquia / arestaEntradaEscolhida formam a árvore
+};
+
+#endif
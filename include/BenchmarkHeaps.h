@@ -0,0 +1,26 @@
+#ifndef BENCHMARKHEAPS_H
+#define BENCHMARKHEAPS_H
+
+#include <vector>
+#include "grafoDirecionadoPonderado.h"
+#include "PoliticasHeap.h"
+
+// Tempos (melhor de 'repeticoes', em ms) de uma politica de heap
+struct ResultadoBenchHeap {
+    PoliticaHeap politica;
+    double construcao = 0;   // Heaps iniciais de todos os vertices
+    double remocoes = 0;     // Esvaziar todos os heaps (E remocoes do minimo)
+    double fusoes = 0;       // Torneio de fusoes com deslocamento, como na contracao
+    double tarjan = 0;       // Solucao completa com espaco de trabalho aquecido
+    double gabow = 0;
+    double pesoTarjan = 0;   // Conferencia: deve ser igual entre politicas
+    double pesoGabow = 0;
+};
+
+// Microbenchmark das politicas de PoliticasHeap.h (modo --bench-heaps)
+class BenchmarkHeaps {
+public:
+    static std::vector<ResultadoBenchHeap> executar(const GrafoDirecionadoPonderado& grafo, int repeticoes);
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef CONTADORESDESEMPENHO_H
+#define CONTADORESDESEMPENHO_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+
+// Eventos medidos em cada fase
+enum EventoDesempenho {
+    CICLOS,
+    INSTRUCOES,
+    FALHAS_CACHE,      // Último nível de cache (PERF_COUNT_HW_CACHE_MISSES)
+    ERROS_DESVIO,
+    FALTAS_PAGINA,
+    NUM_EVENTOS
+};
+
+struct MedicaoFase {
+    std::string nome;
+    double ms = 0.0;
+    uint64_t valores[NUM_EVENTOS] = {};
+
+    // Memória (modo --memoria); -1 quando não medida ou indisponível
+    long rssKB = -1;              // RSS ao fim da fase
+    long picoKB = -1;             // Pico de RSS durante a fase
+    long crescimentoKB = -1;      // Pico menos o RSS no início da fase
+    long long alocacoes = -1;     // Só no build instrumentado (make instrumentado)
+    long long bytesAlocados = -1;
+};
+
+// Contadores de hardware por fase do pipeline (modo --perf), via
+// perf_event_open do Linux. Cada evento é aberto separadamente, só no espaço
+// de usuário e para a thread que chama; os que o kernel ou a máquina não
+// oferecem (VMs costumam não expor os de hardware) aparecem como "-".
+// Desligado ou fora do Linux, as fases só medem o tempo.
+// Com 'memoria' (modo --memoria) cada fase registra também o pico de RSS e,
+// no build instrumentado, o número e o volume de alocações (MedidorMemoria).
+class ContadoresDesempenho {
+public:
+    ContadoresDesempenho(bool hardware, bool memoria = false);
+    ~ContadoresDesempenho();
+
+    ContadoresDesempenho(const ContadoresDesempenho&) = delete;
+    ContadoresDesempenho& operator=(const ContadoresDesempenho&) = delete;
+
+    bool disponivel(EventoDesempenho evento) const { return fd[evento] >= 0; }
+
+    // Fases não se sobrepõem: iniciarFase zera e liga os contadores,
+    // encerrarFase os desliga e guarda a leitura
+    void iniciarFase(const std::string& nome);
+    void encerrarFase();
+
+    const std::vector<MedicaoFase>& fases() const { return medicoes; }
+
+    // Tabela por fase com IPC e falhas de cache / erros de desvio por aresta
+    // do grafo de superpixels ('arestas' = arcos vistos pelo solver) e, com
+    // memória, tabela de RSS e alocações com bytes por pixel e por aresta
+    void imprimir(std::ostream& saida, size_t pixels, size_t arestas) const;
+
+private:
+    void imprimirHardware(std::ostream& saida, size_t arestas) const;
+    void imprimirMemoria(std::ostream& saida, size_t pixels, size_t arestas) const;
+
+    bool hardware;
+    bool memoria;
+    long rssInicioKB = -1;
+    bool picoReiniciado = false;
+    long long alocacoesInicio = 0;
+    long long bytesInicio = 0;
+    int fd[NUM_EVENTOS];
+    std::vector<MedicaoFase> medicoes;
+    std::chrono::steady_clock::time_point inicio;
+};
+
+#endif
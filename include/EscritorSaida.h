@@ -0,0 +1,43 @@
+#ifndef ESCRITORSAIDA_H
+#define ESCRITORSAIDA_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Formatos de saida suportados pelo segmentador
+enum class FormatoSaida {
+    PNG,     // Imagem colorida, compressao configuravel
+    PPM,     // Imagem colorida sem compressao (P6)
+    ROTULOS  // Mapa binario de rotulos uint32 (sem colorizacao)
+};
+
+struct OpcoesSaida {
+    FormatoSaida formato = FormatoSaida::PNG;
+    int nivelCompressaoPng = 8; // 0 = sem compressao, 1-4 = deflate guloso rapido, 5-9 = deflate do stb
+};
+
+// Cabecalho do mapa de rotulos (32 bytes, little-endian).
+// Os rotulos (uint32, um por pixel, em ordem raster) comecam logo apos o
+// cabecalho, alinhados a 4 bytes, permitindo mapear o arquivo com mmap.
+struct CabecalhoRotulos {
+    char magica[4];        // "SEGR"
+    uint32_t versao;
+    uint32_t largura;
+    uint32_t altura;
+    uint32_t numRegioes;
+    uint32_t reservado[3];
+};
+
+class EscritorSaida {
+public:
+    static bool escreverPNG(const std::string& caminho, int largura, int altura, const unsigned char* rgb, int nivelCompressao);
+    static bool escreverPPM(const std::string& caminho, int largura, int altura, const unsigned char* rgb);
+    static bool escreverRotulos(const std::string& caminho, int largura, int altura, const std::vector<uint32_t>& rotulos, uint32_t numRegioes);
+
+    // Extensao padrao ("png", "ppm", "lbl") e conversao a partir do nome usado na CLI
+    static const char* extensao(FormatoSaida formato);
+    static bool formatoPorNome(const std::string& nome, FormatoSaida& formato);
+};
+
+#endif
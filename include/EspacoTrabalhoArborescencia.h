@@ -0,0 +1,132 @@
+#ifndef ESPACOTRABALHOARBORESCENCIA_H
+#define ESPACOTRABALHOARBORESCENCIA_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "grafoDirecionadoPonderado.h"
+
+// Nó das heaps usadas por Tarjan e Gabow (ver PoliticasHeap.h).
+// Skew/Leftist: left/right são os filhos. Pairing: left é o primeiro filho
+// e right o próximo irmão. Nos três casos o 'lazy' vale para o nó e para as
+// subárvores left e right. Na Radix Heap, right encadeia o balde.
+struct NoHeapArborescencia {
+    double val;          // Peso ajustado
+    double lazy;         // Valor para propagação preguiçosa
+    int u, v;            // Aresta
+    int idOriginal;      // ID original para recuperação
+    int rank;            // Distância ao nulo mais próximo (Leftist Heap)
+    NoHeapArborescencia *left, *right;
+};
+
+// Estado da Radix Heap de um componente. Enquanto 'baldes' é -1 os nós
+// ficam numa lista simples; os 65 baldes só são alocados quando o heap
+// precisa remover ou fundir.
+struct EstadoRadix {
+    NoHeapArborescencia* lista;
+    NoHeapArborescencia* menor;   // Mínimo da lista (cache)
+    uint64_t ultimo;              // Chave do último mínimo extraído
+    uint64_t ocupados;            // Bit i: balde i não vazio
+    double deslocamento;          // Peso real = val + deslocamento
+    int baldes;                   // Início dos baldes em 'baldesRadix'
+    int tamanho;
+};
+
+// Union-Find dos supernós. Não usa união por rank: o representante precisa
+// ser sempre o novo supernó (unite(i, novo)), pois os heaps e a hierarquia
+// são indexados por ele. Opera sobre o vetor 'dsuPai' do espaço de trabalho.
+struct DSUSupernos {
+    std::vector<int>& pai;
+    explicit DSUSupernos(std::vector<int>& p) : pai(p) {}
+    int find(int i) {
+        return (pai[i] == i) ? i : (pai[i] = find(pai[i]));
+    }
+    void unite(int i, int j) {
+        int root_i = find(i);
+        int root_j = find(j);
+        if (root_i != root_j) pai[root_i] = root_j;
+    }
+};
+
+// Memória de trabalho dos algoritmos de arborescência (Tarjan e Gabow).
+// Pode ser reaproveitada entre chamadas: os vetores só crescem quando chega
+// um grafo maior, então no regime estável a resolução não aloca nada.
+class EspacoTrabalhoArborescencia {
+public:
+    // Garante capacidade para n vértices e m arestas e reinicia os vetores
+    void preparar(int n, size_t m) {
+        size_t n2 = 2 * (size_t)n;
+
+        if (nos.size() < m) nos.resize(m);
+        nosUsados = 0;
+
+        heaps.assign(n2, nullptr);
+        estadosRadix.clear();
+        baldesRadix.clear();
+        baldesLivres.clear();
+        dsuPai.resize(n2);
+        for (size_t i = 0; i < n2; ++i) dsuPai[i] = (int)i;
+        marca.assign(n2, -1);
+        arestaEntradaEscolhida.assign(n2, -1);
+        pesoEntradaEscolhida.assign(n2, 0.0);
+        paiNaHierarquia.assign(n2, -1);
+
+        arestasEscolhidas.reserve(n);
+        arestasEscolhidas.clear();
+    }
+
+    // Inicializa 'heaps' com as arestas de entrada de cada vértice em tempo
+    // linear: agrupa as arestas por destino (counting sort) e aplica heapify
+    // em cada grupo, ligando os filhos como 2i+1 / 2i+2. Uma árvore binária
+    // ordenada como heap já é uma Skew Heap válida.
+    // Ignora arestas que entram na raiz e auto-loops.
+    void construirHeaps(const VisaoArcos& arestas, int n, int raiz);
+
+    // Árvores binárias de construirHeaps ajustadas para Leftist Heaps
+    // (rank calculado de baixo para cima, filhos trocados quando necessário)
+    void construirHeapsLeftist(const VisaoArcos& arestas, int n, int raiz);
+
+    // Mesmo agrupamento, mas no formato de Pairing Heap: o menor nó de cada
+    // grupo vira a raiz e os demais ficam na lista de filhos.
+    void construirHeapsPairing(const VisaoArcos& arestas, int n, int raiz);
+
+    // Radix Heaps: cada grupo vira a lista inicial do seu destino
+    void construirHeapsRadix(const VisaoArcos& arestas, int n, int raiz);
+
+    // Expande a hierarquia de contração (nós 0..numNos-1 em ordem de criação,
+    // pai em 'paiNaHierarquia' e aresta escolhida em 'arestaEntradaEscolhida')
+    // para a raiz dada, numa única passada de cima para baixo, em O(numNos).
+    // Ao final entradaVertice[v] é a aresta que entra no vértice original v
+    // (-1 se nenhuma). Não altera a hierarquia, que pode ser expandida de novo.
+    void expandirHierarquia(const VisaoArcos& arestas, int numNos, int numVertices, int raiz);
+
+    std::vector<NoHeapArborescencia*> heaps;
+    std::vector<int> dsuPai;
+    std::vector<int> marca;                  // 'visitado' (Tarjan) / 'estado' (Gabow)
+    std::vector<int> arestaEntradaEscolhida;
+    std::vector<double> pesoEntradaEscolhida; // Peso reduzido da aresta escolhida
+    std::vector<int> paiNaHierarquia;        // Supernó que contém o nó (-1 no topo)
+    std::vector<EstadoRadix> estadosRadix;   // Só usado pela Radix Heap
+    std::vector<NoHeapArborescencia*> baldesRadix; // Blocos de 65 baldes
+    std::vector<int> baldesLivres;           // Blocos devolvidos após fusões
+    std::vector<int> entradaVertice;         // Resultado de expandirHierarquia
+    int numNosHierarquia = 0;                // Nós da última hierarquia expandida
+    std::vector<char> removido;
+
+    // Saída: índices (em getArcos) das arestas da arborescência
+    std::vector<int> arestasEscolhidas;
+
+    // Nós colocados nas heaps pela última construção
+    size_t numNosHeap() const { return nosUsados; }
+
+private:
+    // Counting sort das arestas por destino em 'nos'; ao final inicioDestino[v]
+    // aponta para o fim do grupo de v (o início é inicioDestino[v-1] ou 0)
+    void agruparPorDestino(const VisaoArcos& arestas, int n, int raiz);
+
+    std::vector<NoHeapArborescencia> nos;
+    size_t nosUsados = 0;
+    std::vector<int> inicioDestino;          // Deslocamentos do counting sort (n+1)
+};
+
+#endif
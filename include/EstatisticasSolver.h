@@ -0,0 +1,58 @@
+#ifndef ESTATISTICASSOLVER_H
+#define ESTATISTICASSOLVER_H
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+// Contadores de uma resolução de arborescência (Tarjan, Gabow e Edmonds).
+// Os campos de heap ficam em zero no Edmonds, que não usa heaps.
+struct EstatisticasSolver {
+    long long ciclosContraidos = 0;
+    int profundidadeMaxima = 0;      // Maior aninhamento de supernós (0: nenhum ciclo)
+    long long fusoesHeap = 0;
+    long long remocoesHeap = 0;      // Remoções de mínimo
+    long long lacosDescartados = 0;  // Arestas internas a um supernó descartadas
+    int profundidadeRecursao = 0;    // Edmonds: níveis de recursão
+    size_t picoNosHeap = 0;          // Maior número de nós nas heaps ao mesmo tempo
+};
+
+// Coleta das estatísticas dentro dos algoritmos. Com Ativo = false todos os
+// métodos são vazios e o ponteiro nunca é lido, então o compilador remove a
+// coleta por completo; os algoritmos são instanciados uma vez para cada valor.
+template <bool Ativo>
+class ColetorEstatisticas {
+public:
+    explicit ColetorEstatisticas(EstatisticasSolver* e = nullptr) : e(e) {}
+
+    void ciclo() { if constexpr (Ativo) e->ciclosContraidos++; }
+    void fusao() { if constexpr (Ativo) e->fusoesHeap++; }
+    void remocao() { if constexpr (Ativo) e->remocoesHeap++; }
+    void lacosDescartados(long long k = 1) { if constexpr (Ativo) e->lacosDescartados += k; }
+
+    void nosHeap(size_t k) {
+        if constexpr (Ativo) e->picoNosHeap = std::max(e->picoNosHeap, k);
+    }
+    void recursao(int nivel) {
+        if constexpr (Ativo) e->profundidadeRecursao = std::max(e->profundidadeRecursao, nivel);
+    }
+    void aninhamento(int nivel) {
+        if constexpr (Ativo) e->profundidadeMaxima = std::max(e->profundidadeMaxima, nivel);
+    }
+
+    // Aninhamento a partir da hierarquia de contração (pai > filho, -1 no topo)
+    void hierarquia(const std::vector<int>& pai, int numNos) {
+        if constexpr (Ativo) {
+            std::vector<int> nivel(numNos, 0);
+            for (int x = 0; x < numNos; ++x) {
+                if (pai[x] != -1) nivel[pai[x]] = std::max(nivel[pai[x]], nivel[x] + 1);
+                aninhamento(nivel[x]);
+            }
+        }
+    }
+
+private:
+    EstatisticasSolver* e;
+};
+
+#endif
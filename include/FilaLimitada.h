@@ -0,0 +1,72 @@
+#ifndef FILALIMITADA_H
+#define FILALIMITADA_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+// Fila bloqueante de capacidade fixa, usada entre os estagios do pipeline.
+// 'inserir' bloqueia quando a fila esta cheia e 'retirar' quando esta vazia;
+// apos 'fechar', 'retirar' esvazia o que restou e depois retorna false.
+template <typename T>
+class FilaLimitada {
+public:
+    explicit FilaLimitada(size_t capacidade) : capacidade(capacidade < 1 ? 1 : capacidade) {}
+
+    void inserir(T item) {
+        std::unique_lock<std::mutex> trava(mutex);
+        naoCheia.wait(trava, [this] { return itens.size() < capacidade; });
+        itens.push_back(std::move(item));
+        registrarProfundidade();
+        naoVazia.notify_one();
+    }
+
+    bool retirar(T& item) {
+        std::unique_lock<std::mutex> trava(mutex);
+        naoVazia.wait(trava, [this] { return fechada || !itens.empty(); });
+        if (itens.empty()) return false;
+        item = std::move(itens.front());
+        itens.pop_front();
+        naoCheia.notify_one();
+        return true;
+    }
+
+    void fechar() {
+        std::lock_guard<std::mutex> trava(mutex);
+        fechada = true;
+        naoVazia.notify_all();
+    }
+
+    // Estatisticas de ocupacao (amostradas a cada insercao)
+    size_t profundidadeMaxima() const {
+        std::lock_guard<std::mutex> trava(mutex);
+        return maxProfundidade;
+    }
+
+    double profundidadeMedia() const {
+        std::lock_guard<std::mutex> trava(mutex);
+        return amostras ? (double)somaProfundidade / amostras : 0.0;
+    }
+
+    size_t getCapacidade() const { return capacidade; }
+
+private:
+    void registrarProfundidade() {
+        size_t p = itens.size();
+        if (p > maxProfundidade) maxProfundidade = p;
+        somaProfundidade += p;
+        amostras++;
+    }
+
+    const size_t capacidade;
+    std::deque<T> itens;
+    mutable std::mutex mutex;
+    std::condition_variable naoCheia, naoVazia;
+    bool fechada = false;
+
+    size_t maxProfundidade = 0;
+    unsigned long long somaProfundidade = 0;
+    unsigned long long amostras = 0;
+};
+
+#endif
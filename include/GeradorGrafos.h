@@ -0,0 +1,40 @@
+#ifndef GERADORGRAFOS_H
+#define GERADORGRAFOS_H
+
+#include <string>
+#include "grafoDirecionadoPonderado.h"
+
+// Famílias de digrafos sintéticos para testes diferenciais e curvas de escala.
+// Todos os geradores são determinísticos dada a semente e garantem que todo
+// vértice é alcançável a partir do vértice 0 (a raiz usada no harness).
+class GeradorGrafos {
+public:
+    // Grade largura x altura com vizinhança 4 nos dois sentidos e o mesmo peso
+    // em cada sentido, como o grafo de superpixels (simétrico)
+    static GrafoDirecionadoPonderado grade(int largura, int altura, unsigned semente);
+
+    // Esparso: 'grau' arestas de entrada por vértice (pesos uniformes em [0, 1));
+    // um caminho 0 -> 1 -> ... garante alcançabilidade
+    static GrafoDirecionadoPonderado aleatorio(int n, int grau, unsigned semente);
+
+    // Denso: cada par ordenado (u, v) vira aresta com a probabilidade dada
+    static GrafoDirecionadoPonderado denso(int n, double probabilidade, unsigned semente);
+
+    // Completo: todas as n(n-1) arestas
+    static GrafoDirecionadoPonderado completo(int n, unsigned semente);
+
+    // Adversário: cada vértice k forma um 2-ciclo com o supernó {1..k-1}, de modo
+    // que a contração produz uma cadeia de n-2 ciclos aninhados. Força a
+    // profundidade máxima em edmondsRecursivo e fusões sucessivas sempre no
+    // mesmo heap (o do supernó crescente) em Tarjan/Gabow.
+    static GrafoDirecionadoPonderado ciclosAninhados(int n, unsigned semente);
+
+    // Dispatch pelo nome usado na CLI: "grade", "esparso", "denso", "completo", "aninhado".
+    // 'n' é o número aproximado de vértices (a grade usa o quadrado mais próximo).
+    // Retorna false para um nome desconhecido; 'simetrico' indica pesos iguais
+    // nos dois sentidos (caso em que a MST tem o mesmo peso da arborescência).
+    static bool porNome(const std::string& nome, int n, unsigned semente,
+                        GrafoDirecionadoPonderado& grafo, bool& simetrico);
+};
+
+#endif
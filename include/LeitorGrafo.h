@@ -0,0 +1,28 @@
+#ifndef LEITORGRAFO_H
+#define LEITORGRAFO_H
+
+#include <string>
+#include "grafoDirecionadoPonderado.h"
+
+// Formatos de arquivo de grafo aceitos
+enum class FormatoGrafo {
+    LISTA,   // Uma aresta "origem destino peso" por linha, vértices a partir de 0
+    DIMACS   // "p sp <V> <E>" seguido de "a <origem> <destino> <peso>", vértices a partir de 1
+};
+
+// Carrega grafos de outros sistemas para os solvers (modo --grafo).
+// O arquivo é mapeado em memória e dividido em blocos nas quebras de linha;
+// cada bloco é interpretado em paralelo (std::from_chars, sem locale) e as
+// arestas vão direto para o construtor em bloco do grafo.
+// Linhas vazias e comentários ('#', '%' e, em DIMACS, 'c') são ignorados.
+// Erros de formato lançam std::runtime_error com o número da linha.
+class LeitorGrafo {
+public:
+    // threads <= 0: usa todos os núcleos. Sem cabeçalho DIMACS, V = maior índice + 1.
+    static GrafoDirecionadoPonderado carregar(const std::string& caminho, int threads = 0);
+
+    // DIMACS se a primeira linha útil começar por 'p'; lista de arestas caso contrário
+    static FormatoGrafo detectarFormato(const char* inicio, const char* fim);
+};
+
+#endif
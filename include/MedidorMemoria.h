@@ -0,0 +1,28 @@
+#ifndef MEDIDORMEMORIA_H
+#define MEDIDORMEMORIA_H
+
+// Memória do processo para os relatórios por fase (--memoria) e o teste
+// diferencial. RSS e pico vêm de /proc/self/status (Linux; -1 fora dele).
+// A contagem de alocações substitui o operator new global e só existe no
+// build instrumentado ('make instrumentado', que define CONTAR_ALOCACOES);
+// no build normal os contadores valem -1 e new/delete não são tocados.
+class MedidorMemoria {
+public:
+    // Campo de /proc/self/status em kB (VmRSS, VmHWM); -1 se indisponível
+    static long statusKB(const char* campo);
+
+    // Zera o pico de RSS (VmHWM) do processo; false se o kernel não permitir
+    static bool reiniciarPico();
+
+    // Devolve ao sistema a memória livre do alocador; sem isso páginas já
+    // residentes são reaproveitadas e o pico da fase seguinte não cresce
+    static void devolverMemoriaLivre();
+
+    static bool contandoAlocacoes();
+
+    // Totais acumulados desde o início do processo (todas as threads)
+    static long long alocacoes();
+    static long long bytesAlocados();
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef PIPELINELOTE_H
+#define PIPELINELOTE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "ProcessadorLote.h"
+#include "SegmentadorImagem.h"
+
+// Imagem em transito entre os estagios do pipeline
+struct ItemPipeline {
+    size_t indice = 0;
+    std::unique_ptr<SegmentadorImagem> seg;
+    std::unique_ptr<GrafoNaoDirecionadoPonderado> grafo;
+    std::unique_ptr<GrafoDirecionadoPonderado> resultado;
+};
+
+// Lote em estagios: decodificacao -> suavizacao -> grafo -> solver -> rotulos/codificacao.
+// Os estagios sao ligados por filas limitadas, de modo que a E/S de uma imagem
+// (stbi_load, escrita da saida) se sobrepoe ao processamento das outras.
+// Cada estagio roda config.trabalhadores threads; os segmentadores (e seus
+// buffers) sao reciclados do ultimo estagio de volta para o primeiro.
+class PipelineLote {
+public:
+    PipelineLote(const ConfigLote& config, const std::vector<std::string>& entradas, const std::vector<std::string>& saidas);
+
+    ResultadoLote executar();
+
+private:
+    std::unique_ptr<SegmentadorImagem> obterSegmentador();
+    void devolverSegmentador(std::unique_ptr<SegmentadorImagem> seg);
+
+    const ConfigLote& config;
+    const std::vector<std::string>& entradas;
+    const std::vector<std::string>& saidas;
+
+    std::mutex mutexLivres;
+    std::vector<std::unique_ptr<SegmentadorImagem>> segmentadoresLivres;
+};
+
+#endif
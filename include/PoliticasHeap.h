@@ -0,0 +1,367 @@
+#ifndef POLITICASHEAP_H
+#define POLITICASHEAP_H
+
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include "EspacoTrabalhoArborescencia.h"
+
+// Políticas de heap dos algoritmos de arborescência (Tarjan e Gabow).
+// São escolhidas em tempo de compilação (parâmetro de template, sem funções
+// virtuais) e compartilham a mesma interface, endereçada pelo id do
+// componente (vértice original ou supernó):
+//
+//   explicit Politica(EspacoTrabalhoArborescencia&);
+//   void construir(arestas, n, raiz);       // heaps iniciais, tempo linear
+//   No* minimo(int c, double& peso);        // nullptr se vazio; 'peso' já reduzido
+//   void removerMinimo(int c);
+//   void somar(int c, double delta);        // deslocamento lazy em todo o heap
+//   void fundir(int destino, int origem);   // o heap de 'origem' é absorvido
+
+typedef NoHeapArborescencia NoHeap;
+
+enum class PoliticaHeap {
+    SKEW,
+    LEFTIST,
+    PAIRING,
+    RADIX
+};
+
+inline const char* nomePoliticaHeap(PoliticaHeap p) {
+    switch (p) {
+        case PoliticaHeap::LEFTIST: return "leftist";
+        case PoliticaHeap::PAIRING: return "pairing";
+        case PoliticaHeap::RADIX: return "radix";
+        default: return "skew";
+    }
+}
+
+inline bool politicaHeapPorNome(const std::string& nome, PoliticaHeap& p) {
+    if (nome == "skew") p = PoliticaHeap::SKEW;
+    else if (nome == "leftist") p = PoliticaHeap::LEFTIST;
+    else if (nome == "pairing") p = PoliticaHeap::PAIRING;
+    else if (nome == "radix") p = PoliticaHeap::RADIX;
+    else return false;
+    return true;
+}
+
+// Propaga valor lazy para o nó e as subárvores left/right
+inline void propagarLazy(NoHeap* t) {
+    if (!t || t->lazy == 0) return;
+    t->val += t->lazy;
+    if (t->left) t->left->lazy += t->lazy;
+    if (t->right) t->right->lazy += t->lazy;
+    t->lazy = 0;
+}
+
+// Operações das heaps baseadas em árvore (raiz = mínimo)
+
+struct OperacoesSkew {
+    static NoHeap* unir(NoHeap* a, NoHeap* b) {
+        propagarLazy(a);
+        propagarLazy(b);
+        if (!a) return b;
+        if (!b) return a;
+        if (a->val > b->val) std::swap(a, b);
+        std::swap(a->left, a->right);
+        a->left = unir(b, a->left);
+        return a;
+    }
+
+    static NoHeap* removerRaiz(NoHeap* raiz) {
+        propagarLazy(raiz);
+        return unir(raiz->left, raiz->right);
+    }
+
+    static void construir(EspacoTrabalhoArborescencia& e, const VisaoArcos& arestas, int n, int raiz) {
+        e.construirHeaps(arestas, n, raiz);
+    }
+};
+
+struct OperacoesLeftist {
+    static int rank(const NoHeap* t) { return t ? t->rank : 0; }
+
+    // A espinha direita tem O(log n) nós, então a recursão é rasa
+    static NoHeap* unir(NoHeap* a, NoHeap* b) {
+        propagarLazy(a);
+        propagarLazy(b);
+        if (!a) return b;
+        if (!b) return a;
+        if (a->val > b->val) std::swap(a, b);
+        a->right = unir(a->right, b);
+        if (rank(a->left) < rank(a->right)) std::swap(a->left, a->right);
+        a->rank = rank(a->right) + 1;
+        return a;
+    }
+
+    static NoHeap* removerRaiz(NoHeap* raiz) {
+        propagarLazy(raiz);
+        return unir(raiz->left, raiz->right);
+    }
+
+    static void construir(EspacoTrabalhoArborescencia& e, const VisaoArcos& arestas, int n, int raiz) {
+        e.construirHeapsLeftist(arestas, n, raiz);
+    }
+};
+
+// Pairing Heap: left = primeiro filho, right = próximo irmão.
+// Inserção e fusão O(1); remoção do mínimo O(log n) amortizado.
+struct OperacoesPairing {
+    // Liga duas raízes (sem irmãos): a maior vira primeiro filho da menor
+    static NoHeap* unir(NoHeap* a, NoHeap* b) {
+        propagarLazy(a);
+        propagarLazy(b);
+        if (!a) return b;
+        if (!b) return a;
+        if (a->val > b->val) std::swap(a, b);
+        b->right = a->left;
+        a->left = b;
+        return a;
+    }
+
+    // Junta os filhos em pares da esquerda para a direita e depois acumula
+    // os pares da direita para a esquerda (two-pass)
+    static NoHeap* removerRaiz(NoHeap* raiz) {
+        propagarLazy(raiz);
+        NoHeap* prox = raiz->left;
+        NoHeap* pares = nullptr;  // Pilha de pares, encadeada por 'right'
+
+        while (prox) {
+            NoHeap* a = prox;
+            propagarLazy(a);
+            NoHeap* b = a->right;
+            a->right = nullptr;
+            if (b) {
+                propagarLazy(b);
+                prox = b->right;
+                b->right = nullptr;
+                a = unir(a, b);
+            } else {
+                prox = nullptr;
+            }
+            // 'a' não tem lazy pendente, então 'right' pode servir de ligação da pilha
+            a->right = pares;
+            pares = a;
+        }
+
+        NoHeap* resultado = nullptr;
+        while (pares) {
+            NoHeap* seguinte = pares->right;
+            pares->right = nullptr;
+            resultado = unir(resultado, pares);
+            pares = seguinte;
+        }
+        return resultado;
+    }
+
+    static void construir(EspacoTrabalhoArborescencia& e, const VisaoArcos& arestas, int n, int raiz) {
+        e.construirHeapsPairing(arestas, n, raiz);
+    }
+};
+
+// Adapta as operações de árvore à interface comum, usando 'espaco.heaps'
+template <class Operacoes>
+class HeapArvore {
+public:
+    explicit HeapArvore(EspacoTrabalhoArborescencia& e) : espaco(e) {}
+
+    void construir(const VisaoArcos& arestas, int n, int raiz) {
+        Operacoes::construir(espaco, arestas, n, raiz);
+    }
+
+    NoHeap* minimo(int c, double& peso) {
+        NoHeap* r = espaco.heaps[c];
+        if (r) {
+            propagarLazy(r);
+            peso = r->val;
+        }
+        return r;
+    }
+
+    void removerMinimo(int c) { espaco.heaps[c] = Operacoes::removerRaiz(espaco.heaps[c]); }
+
+    void somar(int c, double delta) {
+        if (espaco.heaps[c]) espaco.heaps[c]->lazy += delta;
+    }
+
+    void fundir(int destino, int origem) {
+        espaco.heaps[destino] = Operacoes::unir(espaco.heaps[destino], espaco.heaps[origem]);
+        espaco.heaps[origem] = nullptr;
+    }
+
+private:
+    EspacoTrabalhoArborescencia& espaco;
+};
+
+typedef HeapArvore<OperacoesSkew> HeapSkew;
+typedef HeapArvore<OperacoesLeftist> HeapLeftist;
+typedef HeapArvore<OperacoesPairing> HeapPairing;
+
+// Radix Heap monotônica sobre a representação binária dos pesos.
+// Vale porque, em cada heap, nenhuma chave fica abaixo do último mínimo:
+// ao contrair um ciclo cada heap é deslocado pelo seu próprio mínimo, e
+// todas as chaves reduzidas ficam >= 0 >= último mínimo deslocado.
+// O deslocamento é guardado por heap (O(1)); na fusão os nós do heap
+// menor são reinseridos no maior, o que dá O(E log V) reinserções.
+class HeapRadix {
+public:
+    static const int NUM_BALDES = 65;
+
+    explicit HeapRadix(EspacoTrabalhoArborescencia& e) : espaco(e), estados(e.estadosRadix) {}
+
+    void construir(const VisaoArcos& arestas, int n, int raiz) {
+        espaco.construirHeapsRadix(arestas, n, raiz);
+    }
+
+    NoHeap* minimo(int c, double& peso) {
+        EstadoRadix& h = estados[c];
+        if (h.tamanho == 0) return nullptr;
+
+        NoHeap* m;
+        if (h.baldes < 0) {
+            if (!h.menor) {
+                h.menor = h.lista;
+                for (NoHeap* x = h.lista->right; x; x = x->right)
+                    if (x->val < h.menor->val) h.menor = x;
+            }
+            m = h.menor;
+        } else {
+            m = minimoBaldes(h);
+        }
+        peso = m->val + h.deslocamento;
+        return m;
+    }
+
+    void removerMinimo(int c) {
+        EstadoRadix& h = estados[c];
+        if (h.tamanho == 0) return;
+        distribuir(h);
+        minimoBaldes(h);
+
+        NoHeap** b = balde(h, 0);
+        *b = (*b)->right;
+        if (!*b) h.ocupados &= ~1ull;
+        h.tamanho--;
+    }
+
+    void somar(int c, double delta) { estados[c].deslocamento += delta; }
+
+    void fundir(int destino, int origem) {
+        EstadoRadix& d = estados[destino];
+        EstadoRadix& o = estados[origem];
+        if (o.tamanho == 0) return;
+        if (d.tamanho < o.tamanho) std::swap(d, o);
+        if (o.tamanho == 0) return;
+
+        distribuir(d);
+        double ajuste = o.deslocamento - d.deslocamento;
+
+        // Reinsere os nós do heap menor no maior
+        if (o.baldes < 0) {
+            for (NoHeap* x = o.lista; x;) {
+                NoHeap* prox = x->right;
+                x->val += ajuste;
+                inserir(d, x);
+                x = prox;
+            }
+        } else {
+            for (int i = 0; i < NUM_BALDES; ++i) {
+                for (NoHeap* x = *balde(o, i); x;) {
+                    NoHeap* prox = x->right;
+                    x->val += ajuste;
+                    inserir(d, x);
+                    x = prox;
+                }
+            }
+            espaco.baldesLivres.push_back(o.baldes);
+        }
+        d.tamanho += o.tamanho;
+        o = EstadoRadix{nullptr, nullptr, 0, 0, 0.0, -1, 0};
+    }
+
+private:
+    // Mapeia double em uint64 preservando a ordem (inclusive negativos)
+    static uint64_t chave(double x) {
+        uint64_t b;
+        std::memcpy(&b, &x, sizeof b);
+        return (b >> 63) ? ~b : (b | (1ull << 63));
+    }
+
+    static double valor(uint64_t k) {
+        uint64_t b = (k >> 63) ? (k & ~(1ull << 63)) : ~k;
+        double x;
+        std::memcpy(&x, &b, sizeof x);
+        return x;
+    }
+
+    static int indiceBalde(uint64_t k, uint64_t ultimo) {
+        return k == ultimo ? 0 : 64 - __builtin_clzll(k ^ ultimo);
+    }
+
+    NoHeap** balde(EstadoRadix& h, int i) { return &espaco.baldesRadix[h.baldes + i]; }
+
+    void inserir(EstadoRadix& h, NoHeap* x) {
+        uint64_t k = chave(x->val);
+        if (k < h.ultimo) {
+            // Só acontece por arredondamento no ajuste de deslocamento
+            x->val = valor(h.ultimo);
+            k = h.ultimo;
+        }
+        int i = indiceBalde(k, h.ultimo);
+        NoHeap** b = balde(h, i);
+        x->right = *b;
+        *b = x;
+        h.ocupados |= 1ull << i;
+    }
+
+    // Sai do modo lista: aloca os baldes e distribui os nós em relação ao mínimo
+    void distribuir(EstadoRadix& h) {
+        if (h.baldes >= 0) return;
+
+        if (!espaco.baldesLivres.empty()) {
+            h.baldes = espaco.baldesLivres.back();
+            espaco.baldesLivres.pop_back();
+        } else {
+            h.baldes = (int)espaco.baldesRadix.size();
+            espaco.baldesRadix.resize(espaco.baldesRadix.size() + NUM_BALDES);
+        }
+        std::fill(espaco.baldesRadix.begin() + h.baldes, espaco.baldesRadix.begin() + h.baldes + NUM_BALDES, nullptr);
+        h.ocupados = 0;
+
+        NoHeap* x = h.lista;
+        h.ultimo = x ? chave(x->val) : 0;
+        for (NoHeap* y = x; y; y = y->right) h.ultimo = std::min(h.ultimo, chave(y->val));
+        while (x) {
+            NoHeap* prox = x->right;
+            inserir(h, x);
+            x = prox;
+        }
+        h.lista = h.menor = nullptr;
+    }
+
+    // Garante que o balde 0 contém o mínimo e o retorna
+    NoHeap* minimoBaldes(EstadoRadix& h) {
+        if (!(h.ocupados & 1)) {
+            int i = __builtin_ctzll(h.ocupados);
+            NoHeap** b = balde(h, i);
+            uint64_t novo = ~0ull;
+            for (NoHeap* x = *b; x; x = x->right) novo = std::min(novo, chave(x->val));
+
+            NoHeap* x = *b;
+            *b = nullptr;
+            h.ocupados &= ~(1ull << i);
+            h.ultimo = novo;
+            while (x) {
+                NoHeap* prox = x->right;
+                inserir(h, x);
+                x = prox;
+            }
+        }
+        return *balde(h, 0);
+    }
+
+    EspacoTrabalhoArborescencia& espaco;
+    std::vector<EstadoRadix>& estados;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef POOLTHREADS_H
+#define POOLTHREADS_H
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Pool de threads simples com fila de tarefas.
+// Cada tarefa recebe o indice do trabalhador que a executa, o que permite
+// manter buffers por trabalhador reaproveitados entre tarefas.
+class PoolThreads {
+public:
+    explicit PoolThreads(int numTrabalhadores);
+    ~PoolThreads();
+
+    PoolThreads(const PoolThreads&) = delete;
+    PoolThreads& operator=(const PoolThreads&) = delete;
+
+    void enfileirar(std::function<void(int)> tarefa);
+
+    // Bloqueia ate que todas as tarefas enfileiradas tenham terminado
+    void aguardar();
+
+    int numTrabalhadores() const;
+
+private:
+    void laco(int idTrabalhador);
+
+    std::vector<std::thread> trabalhadores;
+    std::queue<std::function<void(int)>> tarefas;
+    std::mutex mutex;
+    std::condition_variable temTarefa;
+    std::condition_variable semPendentes;
+    int pendentes;
+    bool encerrando;
+};
+
+#endif
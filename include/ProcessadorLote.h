@@ -0,0 +1,66 @@
+#ifndef PROCESSADORLOTE_H
+#define PROCESSADORLOTE_H
+
+#include <string>
+#include <vector>
+#include "EscritorSaida.h"
+#include "PoliticasHeap.h"
+#include "SegmentadorImagem.h"
+
+struct ConfigLote {
+    std::string entrada;         // Diretorio de imagens ou arquivo texto com um caminho por linha
+    std::string diretorioSaida;
+    int trabalhadores = 1;
+    int metodo = 2;
+    double limiar = 0.06;
+    OpcoesSaida opcoesSaida;
+    bool pipeline = false;       // Estagios com filas limitadas em vez de uma imagem por tarefa
+    PoliticaHeap heap = PoliticaHeap::SKEW; // Heap usada por Tarjan e Gabow
+    int raiz = 0;                // -1: maior superpixel de cada imagem
+    bool verificar = false;      // Verifica a otimalidade de cada resultado (falha conta como erro)
+    std::string diretorioCache;  // Cache dos grafos de superpixels (vazio: desligado)
+    OrdemSupernos ordem = OrdemSupernos::VARREDURA; // Numeração dos superpixels
+    int superpixels = 0;         // Alvo do SLIC (0: agrupamento por limiar de cor)
+    int piramide = 0;            // Niveis da piramide de previa (0: resolucao original)
+    RegiaoInteresse regiao;      // Mesmo recorte em todas as imagens (padrao: imagem inteira)
+};
+
+// Ocupacao de um estagio do pipeline e da fila que o alimenta
+struct EstatisticaEstagio {
+    std::string nome;
+    int threads = 0;
+    double utilizacao = 0.0;     // Tempo ocupado / (threads * tempo total)
+    size_t capacidadeFila = 0;   // 0: estagio sem fila de entrada
+    size_t filaMaxima = 0;
+    double filaMedia = 0.0;
+};
+
+struct ResultadoLote {
+    int processadas = 0;
+    int falhas = 0;
+    double megapixels = 0.0;
+    double segundos = 0.0;
+    std::vector<EstatisticaEstagio> estagios; // Preenchido apenas no modo pipeline
+};
+
+// Processa varias imagens em paralelo em um pool de threads.
+// Cada trabalhador mantem o seu proprio SegmentadorImagem, cujos buffers
+// sao reaproveitados de uma imagem para a outra. Com config.pipeline a
+// execucao e delegada ao PipelineLote.
+class ProcessadorLote {
+public:
+    explicit ProcessadorLote(const ConfigLote& config);
+
+    ResultadoLote executar();
+
+    static std::vector<std::string> listarEntradas(const std::string& entrada);
+
+    // Nomes de saida unicos por imagem: <diretorio>/<nome>_<metodo>.<ext>
+    static std::vector<std::string> nomesSaida(const std::vector<std::string>& entradas, const std::string& diretorio,
+                                               const char* nomeMetodo, FormatoSaida formato);
+
+private:
+    ConfigLote config;
+};
+
+#endif
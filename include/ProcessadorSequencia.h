@@ -0,0 +1,55 @@
+#ifndef PROCESSADORSEQUENCIA_H
+#define PROCESSADORSEQUENCIA_H
+
+#include <string>
+#include <vector>
+#include "EscritorSaida.h"
+#include "PoliticasHeap.h"
+#include "SegmentadorImagem.h"
+
+struct ConfigSequencia {
+    std::string entrada;         // Diretorio de quadros (ordem alfabetica) ou arquivo texto com um caminho por linha
+    std::string diretorioSaida;
+    int metodo = 2;
+    double limiar = 0.06;
+    OpcoesSaida opcoesSaida;
+    PoliticaHeap heap = PoliticaHeap::SKEW;
+    int raiz = 0;                // -1: maior superpixel de cada quadro
+    bool verificar = false;
+    int piramide = 0;
+    RegiaoInteresse regiao;
+    int ladrilho = 32;           // Lado dos ladrilhos comparados com o quadro de referencia
+    int tolerancia = 8;          // Diferenca maxima por canal num ladrilho considerado intacto
+    bool comparar = false;       // Refaz cada quadro do zero para comparar latencia e peso
+};
+
+// Latencia e tamanho do grafo de um quadro
+struct QuadroSequencia {
+    std::string caminho;
+    bool ok = false;
+    bool completo = true;        // Grafo refeito do zero
+    double fracaoAlterada = 1.0; // Ladrilhos alterados / total
+    double fracaoReagrupada = 1.0; // Pixels reagrupados / total
+    int supernos = 0;
+    int supernosMantidos = 0;
+    double msIncremental = 0.0;  // Grafo + solver
+    double msCompleto = -1.0;    // Grafo + solver do zero (so com 'comparar')
+    double peso = 0.0;
+    double pesoCompleto = -1.0;
+};
+
+// Segmenta os quadros em ordem com um unico SegmentadorImagem: cada grafo e
+// atualizado a partir do anterior (criarGrafoIncremental). O Kruskal parte da
+// ordem de pesos do quadro anterior e so ordena as arestas novas; os demais
+// metodos reaproveitam o espaco de trabalho do solver entre quadros.
+class ProcessadorSequencia {
+public:
+    explicit ProcessadorSequencia(const ConfigSequencia& config);
+
+    std::vector<QuadroSequencia> executar();
+
+private:
+    ConfigSequencia config;
+};
+
+#endif
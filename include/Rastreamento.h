@@ -0,0 +1,60 @@
+#ifndef RASTREAMENTO_H
+#define RASTREAMENTO_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Linha do tempo da execução no formato Chrome trace (JSON), aberta em
+// chrome://tracing ou ui.perfetto.dev (opção --rastro). Cada thread grava os
+// seus eventos num buffer próprio, sem trava; o arquivo é montado no fim.
+// Desligado, um EscopoRastro custa só a leitura de um atômico.
+class Rastreamento {
+public:
+    // Passa a registrar eventos; os tempos contam a partir desta chamada
+    static void iniciar();
+
+    static bool ativo() { return ligado.load(std::memory_order_relaxed); }
+
+    // Nome da thread chamadora na linha do tempo (sem efeito se desligado)
+    static void nomearThread(const std::string& nome);
+
+    // Para de registrar e escreve o JSON. As threads que gravaram eventos
+    // devem ter terminado (ou estar ociosas) antes da chamada.
+    static bool salvar(const std::string& caminho);
+
+    // Usados pelo EscopoRastro
+    static int64_t agoraNs();
+    static void registrar(const char* nome, const char* detalhe, int64_t inicioNs, int64_t fimNs);
+
+private:
+    static std::atomic<bool> ligado;
+};
+
+// Evento com duração: do construtor até encerrar() ou o destrutor.
+// 'nome' deve ser um literal (ou viver até o fim do programa); 'detalhe'
+// (caminho da imagem, método), se dado, é copiado no fim e aparece em args.
+class EscopoRastro {
+public:
+    explicit EscopoRastro(const char* nome, const char* detalhe = nullptr)
+        : nome(Rastreamento::ativo() ? nome : nullptr), detalhe(detalhe) {
+        if (this->nome) inicio = Rastreamento::agoraNs();
+    }
+    ~EscopoRastro() { encerrar(); }
+
+    EscopoRastro(const EscopoRastro&) = delete;
+    EscopoRastro& operator=(const EscopoRastro&) = delete;
+
+    void encerrar() {
+        if (!nome) return;
+        Rastreamento::registrar(nome, detalhe, inicio, Rastreamento::agoraNs());
+        nome = nullptr;
+    }
+
+private:
+    const char* nome;
+    const char* detalhe;
+    int64_t inicio = 0;
+};
+
+#endif
@@ -4,7 +4,73 @@
 #include <string>
 #include <vector>
 #include <tuple>
-#include "grafoDirecionadoPonderado.h"
+#include <cstdint>
+#include "grafoNaoDirecionadoPonderado.h"
+#include "EscritorSaida.h"
+#include "UnionFind.h"
+
+// Numeração dos superpixels. VARREDURA é a ordem do primeiro pixel de cada
+// um na varredura da imagem; HILBERT e MORTON ordenam pelo índice do centróide
+// na curva correspondente, para que superpixels vizinhos na imagem tenham ids
+// (e posições em heaps, DSU e vetores de arestas) próximos.
+enum class OrdemSupernos {
+    VARREDURA,
+    HILBERT,
+    MORTON
+};
+
+inline const char* nomeOrdemSupernos(OrdemSupernos o) {
+    switch (o) {
+        case OrdemSupernos::HILBERT: return "hilbert";
+        case OrdemSupernos::MORTON: return "morton";
+        default: return "varredura";
+    }
+}
+
+inline bool ordemSupernosPorNome(const std::string& nome, OrdemSupernos& o) {
+    if (nome == "varredura") o = OrdemSupernos::VARREDURA;
+    else if (nome == "hilbert") o = OrdemSupernos::HILBERT;
+    else if (nome == "morton") o = OrdemSupernos::MORTON;
+    else return false;
+    return true;
+}
+
+// Cabeçalho do cache do grafo de superpixels (64 bytes, little-endian).
+// Seguem, nesta ordem: peso (double, numArestas), inicio (uint32, numSupernos + 1),
+// destino (uint32, numArestas) — o grafo em CSR por origem, uma aresta por
+// par com origem < destino —, pixelParaSuperno
+// (int32, largura * altura), pixels por superno (uint32, numSupernos) e a cor
+// média de cada superno (3 x uint8). Os pesos vêm primeiro para ficarem
+// alinhados a 8 bytes quando o arquivo é mapeado com mmap.
+struct CabecalhoCacheGrafo {
+    char magica[4];        // "SGCG"
+    uint32_t versao;
+    uint64_t chave;        // FNV-1a da imagem (após a suavização) e dos parâmetros de agrupamento
+    uint32_t largura;
+    uint32_t altura;
+    uint32_t numSupernos;
+    uint32_t numArestas;
+    uint32_t reservado[8];
+};
+
+// Retângulo em coordenadas de pixel da imagem original; largura ou altura
+// <= 0 significa a imagem inteira
+struct RegiaoInteresse {
+    int x = 0, y = 0;
+    int largura = 0, altura = 0;
+
+    bool inteira() const { return largura <= 0 || altura <= 0; }
+};
+
+// Resultado de SegmentadorImagem::criarGrafoIncremental
+struct AtualizacaoGrafo {
+    bool completa = true;         // Grafo refeito do zero (primeiro quadro, tamanho ou numeração diferente)
+    int ladrilhosAlterados = 0;
+    int ladrilhosTotal = 0;
+    int pixelsReagrupados = 0;
+    int supernosMantidos = 0;     // Ids 0..supernosMantidos-1: superpixels do quadro anterior, na mesma ordem
+    std::vector<int> idNovo;      // Id no quadro anterior -> id atual (-1: reagrupado)
+};
 
 class SegmentadorImagem {
 public:
@@ -13,20 +79,126 @@ public:
 
     bool carregarImagem(const std::string& caminho);
 
-    GrafoDirecionadoPonderado criarGrafo();
+    // Grafo simétrico de superpixels (cada adjacência guardada uma vez)
+    GrafoNaoDirecionadoPonderado criarGrafo();
 
-    void salvarSegmentacao(const GrafoDirecionadoPonderado& arborescencia, const std::string& saida, double limiarCorte);
+    // Para quadros de uma sequência: compara a imagem (já suavizada) com a de
+    // referência em ladrilhos de 'ladrilho' pixels; um ladrilho muda quando
+    // algum canal difere mais que 'tolerancia'. Os superpixels que tocam
+    // ladrilhos alterados são reagrupados pelo mesmo critério de criarGrafo
+    // (podendo se unir aos vizinhos intactos); os demais mantêm pixels, cor e
+    // arestas entre si. Com tolerancia 0 o resultado é o de criarGrafo.
+    // Sem referência compatível, faz criarGrafo.
+    GrafoNaoDirecionadoPonderado criarGrafoIncremental(int ladrilho, int tolerancia, AtualizacaoGrafo& info);
+
+    // Retorna false se o arquivo de saida nao pode ser gravado
+    bool salvarSegmentacao(const GrafoDirecionadoPonderado& arborescencia, const std::string& saida, double limiarCorte,
+                           const OpcoesSaida& opcoes = OpcoesSaida());
+
+    // Rotula cada pixel com a regiao (componente apos o corte). Retorna o numero de regioes.
+    // Na piramide, os rotulos saem na resolucao original, ja refinados nas bordas.
+    int rotularRegioes(const GrafoDirecionadoPonderado& arborescencia, double limiarCorte, std::vector<uint32_t>& rotulosPixel);
     
     void aplicarSuavizacao(); 
 
+    // Superpixel com mais pixels no ultimo grafo criado (candidato a raiz);
+    // empates vão para o primeiro na ordem de varredura
+    int maiorSuperpixel() const;
+
+    // Raiz pedida na CLI: -1 = maior superpixel, k = k-ésimo superpixel na
+    // ordem de varredura, qualquer que seja a numeração usada no grafo
+    int supernoRaiz(int raiz) const;
+
+    // Dimensões da imagem carregada (e da saída): a região de interesse, se
+    // houver, mesmo com a pirâmide ligada
+    int getLargura() const { return larguraCheia; }
+    int getAltura() const { return alturaCheia; }
+
+    // Desliga as mensagens de progresso (usado no modo lote)
+    void setVerboso(bool v) { verboso = v; }
+
+    // Com um diretório definido, criarGrafo procura o grafo em <dir>/<chave>.sgc
+    // antes de construí-lo e grava o resultado quando não o encontra
+    void setDiretorioCache(const std::string& diretorio) { diretorioCache = diretorio; }
+
+    // Numeração dos superpixels nos próximos grafos (padrão: VARREDURA).
+    // Com HILBERT/MORTON as arestas também saem ordenadas por (origem, destino).
+    void setOrdemSupernos(OrdemSupernos o) { ordem = o; }
+
+    // Com alvo > 0 os superpixels vêm do SLIC (cerca de 'alvo' regiões
+    // compactas) em vez do agrupamento por limiar de cor, o que limita o
+    // tamanho do grafo. 'threads' divide as iterações em faixas de linhas
+    // (<= 0: todos os núcleos).
+    void setSuperpixelsAlvo(int alvo) { superpixelsAlvo = alvo; }
+    void setThreadsSLIC(int threads) { threadsSLIC = threads; }
+
+    // Pirâmide para prévias: com n > 0, carregarImagem reduz a imagem 2^n vezes
+    // em cada eixo (média dos blocos) e todo o pipeline roda nessa escala; só
+    // os pixels de borda entre regiões são reavaliados na resolução original
+    void setNiveisPiramide(int n) { niveisPiramide = n; }
+
+    // Só a região é segmentada: carregarImagem recorta o retângulo (limitado à
+    // imagem) com uma margem de um pixel para a suavização, descartada antes
+    // de criarGrafo; o restante do pipeline e a saída têm o tamanho da região.
+    // Retângulo fora da imagem faz carregarImagem falhar.
+    void setRegiaoInteresse(const RegiaoInteresse& r) { regiaoInteresse = r; }
+
 private:
     unsigned char* dadosImagem;
     int largura, altura, canais;
+    int larguraCheia, alturaCheia;
+    int niveisPiramide;
+    RegiaoInteresse regiaoInteresse;
+    int haloEsquerda, haloTopo, haloDireita, haloBase; // Margem ainda presente em dadosImagem
+    bool verboso;
+    OrdemSupernos ordem;
+    int superpixelsAlvo;
+    int threadsSLIC;
+
+    // Buffers reaproveitados entre imagens (um segmentador por thread no modo lote)
+    std::vector<unsigned char> bufferSuavizacao;
+    UnionFind ufPixels;
+    std::vector<long long> sumR, sumG, sumB;
+    std::vector<int> countPixel;
+    std::vector<int> rootToId;
+    std::vector<long long> sumX, sumY;
+    std::vector<uint64_t> chaveCurva;
+    std::vector<int> porChave, novoId;
+    std::vector<int> rotuloSLIC, tamanhoSLIC;
+    std::vector<double> centrosSLIC, acumuladoresSLIC;
+    std::vector<unsigned char> imagemCheia;
+    std::vector<uint32_t> rotulosGrossos;
+    std::vector<long long> somaRegiao;
+    std::vector<double> mediaRegiao;
+
+    // Referência de criarGrafoIncremental: cada pixel guarda o valor com que
+    // foi agrupado pela última vez
+    std::vector<unsigned char> quadroReferencia;
+    int larguraReferencia;
+    std::vector<char> ladrilhoAlterado, supernoSujo;
+    std::vector<int> pixelsSujos, pixelsNovos, representante, contagemComponente, idComponente;
    
     std::vector<int> pixelParaSuperno;
     
     std::vector<std::tuple<int, int, int>> coresSupernos;
 
+    // Grafo de superpixels em CSR por origem (também é o formato do cache)
+    std::vector<uint32_t> csrInicio, csrDestino;
+    std::vector<double> csrPeso;
+    std::string diretorioCache;
+
+    uint64_t chaveCache() const;
+    bool carregarCache(const std::string& caminho, uint64_t chave, GrafoNaoDirecionadoPonderado& grafo);
+    bool salvarCache(const std::string& caminho, uint64_t chave) const;
+
+    void renumerarSupernos(int numSupernos);
+    void agruparSLIC(UnionFind& uf);
+    void reduzirPiramide();
+    void recortar(int x0, int y0, int novaLargura, int novaAltura);
+    void removerHalo();
+    void montarCSR(int numSupernos, const std::vector<Aresta>& arestas);
+    void refinarPiramide(std::vector<uint32_t>& rotulosPixel, int numRegioes);
+
     double calcularDiferencaCor(int idx1, int idx2);
     double calcularDiferencaCorMedia(std::tuple<int,int,int> c1, std::tuple<int,int,int> c2);
     
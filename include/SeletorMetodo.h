@@ -0,0 +1,49 @@
+#ifndef SELETORMETODO_H
+#define SELETORMETODO_H
+
+#include "grafoDirecionadoPonderado.h"
+#include "EspacoTrabalhoArborescencia.h"
+#include "PoliticasHeap.h"
+#include "VerificadorOtimalidade.h"
+#include "EstatisticasSolver.h"
+
+// Despacho dos metodos numerados da CLI (0: Edmonds, 1: Kruskal, 2: Tarjan, 3: Gabow,
+// 4: Arvore de contracao)
+class SeletorMetodo {
+public:
+    static bool valido(int metodo);
+
+    // Nome curto usado nos arquivos de saida (ex: "tarjan")
+    static const char* nome(int metodo);
+
+    // Descricao exibida ao executar (ex: "Tarjan (Otimizado c/ Skew Heaps)")
+    static const char* descricao(int metodo);
+
+    // Executa o metodo sobre o grafo de superpixels. Para Kruskal o grafo e
+    // convertido para nao direcionado antes; a MST retorna como grafo base.
+    // Os metodos 2 e 3 reaproveitam 'espaco' quando informado (modo lote); os metodos
+    // 2 a 4 usam a politica de heap 'heap'.
+    // Com 'estatisticas', os metodos 0 a 3 preenchem os contadores da resolucao
+    // (Kruskal so zera a estrutura; a arvore de contracao nao os coleta).
+    static GrafoDirecionadoPonderado resolver(int metodo, GrafoDirecionadoPonderado& grafo, int raiz = 0,
+                                              EspacoTrabalhoArborescencia* espaco = nullptr,
+                                              PoliticaHeap heap = PoliticaHeap::SKEW,
+                                              EstatisticasSolver* estatisticas = nullptr);
+
+    // Se verificar vale para o metodo: Edmonds e a arvore de contracao nao
+    // deixam certificado dual
+    static bool verificavel(int metodo);
+
+    // Lanca std::runtime_error com a explicacao se o metodo nao e verificavel
+    static void exigirVerificavel(int metodo);
+
+    // Verifica a otimalidade de 'resultado' (retorno de resolver). Kruskal usa a
+    // propriedade do ciclo; os metodos 2 e 3 usam o certificado dual deixado em
+    // 'espaco' pela resolucao, que entao e obrigatorio. Nos demais metodos lanca
+    // std::runtime_error em vez de resolver de novo para obter um certificado.
+    static ResultadoVerificacao verificar(int metodo, GrafoDirecionadoPonderado& grafo, int raiz,
+                                          const GrafoDirecionadoPonderado& resultado,
+                                          EspacoTrabalhoArborescencia* espaco = nullptr);
+};
+
+#endif
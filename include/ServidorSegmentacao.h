@@ -0,0 +1,58 @@
+#ifndef SERVIDORSEGMENTACAO_H
+#define SERVIDORSEGMENTACAO_H
+
+#include <string>
+#include <vector>
+#include "EscritorSaida.h"
+#include "PoliticasHeap.h"
+
+// Protocolo (texto, uma linha por mensagem, campos separados por tabulação):
+//   requisição: imagem=<caminho>  saida=<caminho>  metodo=<0-4>  limiar=<l1[,l2...]>
+//               [formato=png|ppm|rotulos] [compressao=0-9] [raiz=<indice|maior>]
+//               [heap=<nome>] [verificar=1]
+//   resposta:   ok  supernos=N  carregar_ms=..  suavizar_ms=..  grafo_ms=..
+//               resolver_ms=..  salvar_ms=..  total_ms=..  trabalhador=k
+//               ou  erro  <mensagem>
+// Com vários limiares o grafo e a arborescência são calculados uma vez e cada
+// limiar grava <saida sem extensão>_<i>.<ext>. A linha "sair" encerra o servidor.
+struct RequisicaoSegmentacao {
+    std::string imagem;
+    std::string saida;
+    int metodo = 2;
+    std::vector<double> limiares;
+    OpcoesSaida opcoesSaida;
+    int raiz = 0;                // -1: maior superpixel
+    PoliticaHeap heap = PoliticaHeap::SKEW;
+    bool verificar = false;
+
+    // Lança std::runtime_error com a descrição do campo inválido
+    static RequisicaoSegmentacao interpretar(const std::string& linha);
+};
+
+struct ConfigServidor {
+    std::string caminhoSocket;
+    int trabalhadores = 1;
+    std::string diretorioCache;  // Cache dos grafos de superpixels (vazio: desligado)
+};
+
+// Servidor de longa duração num socket Unix local. Uma thread lê todas as
+// conexões e enfileira cada requisição no pool; o trabalhador que a atende usa
+// o seu SegmentadorImagem e espaço de trabalho do solver, mantidos aquecidos
+// entre requisições. Uma conexão pode enviar várias requisições, respondidas
+// em ordem, e ociosa não ocupa trabalhador. Fora do POSIX, executar() falha.
+class ServidorSegmentacao {
+public:
+    explicit ServidorSegmentacao(const ConfigServidor& config);
+
+    // Bloqueia até receber "sair" e terminar as requisições já recebidas;
+    // retorna o número de requisições atendidas
+    int executar();
+
+    // Cliente: envia cada linha numa mesma conexão e devolve as respostas
+    static std::vector<std::string> enviar(const std::string& caminhoSocket, const std::vector<std::string>& linhas);
+
+private:
+    ConfigServidor config;
+};
+
+#endif
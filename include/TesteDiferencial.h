@@ -0,0 +1,56 @@
+#ifndef TESTEDIFERENCIAL_H
+#define TESTEDIFERENCIAL_H
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include "PoliticasHeap.h"
+
+struct ConfigDiferencial {
+    std::vector<std::string> geradores = {"grade", "esparso", "denso", "completo", "aninhado"};
+    int verticesMin = 64;
+    int verticesMax = 16384;    // V dobra de verticesMin até aqui
+    unsigned semente = 1;
+    double limiteEdmonds = 4e6; // Edmonds (O(VE) por nível de contração) só até este V·E
+    int limiteDenso = 4096;     // "denso" e "completo" só até este V
+    PoliticaHeap heap = PoliticaHeap::SKEW;
+    bool verificar = true;      // Também confere cada resultado com VerificadorOtimalidade
+};
+
+// Uma execução de um método sobre uma instância
+struct MedicaoDiferencial {
+    std::string gerador;
+    int vertices = 0;
+    size_t arestas = 0;
+    int metodo = 0;
+    double ms = 0.0;
+    long memoriaKB = -1;        // Pico de RSS durante a resolução menos o RSS antes dela (-1: indisponível)
+    long long alocacoes = -1;   // Chamadas ao operator new na resolução (-1 fora do build instrumentado)
+    long long bytesAlocados = -1;
+    double peso = 0.0;
+    bool otimo = true;
+};
+
+struct ResultadoDiferencial {
+    std::vector<MedicaoDiferencial> medicoes;
+    int divergencias = 0;       // Pesos diferentes entre métodos ou verificação reprovada
+};
+
+// Teste diferencial e curvas de escala (modo --diferencial): roda todos os
+// métodos sobre as famílias de GeradorGrafos com V crescente, exige o mesmo
+// peso total de todas as arborescências (e da MST quando o grafo é simétrico)
+// e registra tempo e memória de cada execução.
+class TesteDiferencial {
+public:
+    explicit TesteDiferencial(const ConfigDiferencial& config);
+
+    ResultadoDiferencial executar(std::ostream& log);
+
+    // Uma linha por medição: gerador,vertices,arestas,metodo,ms,memoria_kb,peso,otimo
+    static bool escreverCSV(const std::string& caminho, const std::vector<MedicaoDiferencial>& medicoes);
+
+private:
+    ConfigDiferencial config;
+};
+
+#endif
@@ -9,7 +9,12 @@ class UnionFind {
     std::vector<int> rank;
 
 public:
-    UnionFind(int n) {
+    UnionFind(int n = 0) {
+        reiniciar(n);
+    }
+
+    // Reinicia para n conjuntos unitarios, reaproveitando a memoria ja alocada
+    void reiniciar(int n) {
         pai.resize(n);
         std::iota(pai.begin(), pai.end(), 0); // Preenche com 0, 1, 2...
         rank.assign(n, 0);
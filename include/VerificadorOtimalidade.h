@@ -0,0 +1,46 @@
+#ifndef VERIFICADOROTIMALIDADE_H
+#define VERIFICADOROTIMALIDADE_H
+
+#include <vector>
+#include <string>
+#include "grafoDirecionadoPonderado.h"
+#include "EspacoTrabalhoArborescencia.h"
+
+// Certificado dual de uma arborescência mínima: família laminar de conjuntos
+// (nós 0..n-1 são os vértices, os demais são supernós com pai[x] > x) e um
+// valor y por conjunto. Vem da hierarquia de contração de Tarjan/Gabow:
+// y = peso reduzido da aresta escolhida pelo nó.
+struct CertificadoArborescencia {
+    std::vector<int> pai;
+    std::vector<double> y;
+};
+
+struct ResultadoVerificacao {
+    bool otimo = false;
+    std::string motivo;          // Primeira violação encontrada (vazio se ótimo)
+    double pesoArvore = 0.0;
+    double limiteDual = 0.0;     // Soma de y (arborescência) ou igual ao peso (MST)
+};
+
+// Verificação de otimalidade sem reexecutar um algoritmo exato.
+// Arborescência: estrutura + viabilidade dual (para cada aresta u->v, a soma
+// de y nos conjuntos que contêm v e não u não passa de w) + soma de y igual
+// ao peso da árvore. MST: propriedade do ciclo (nenhuma aresta fora da árvore
+// é mais leve que a maior aresta do caminho na árvore), com o caminho máximo
+// obtido pela árvore de reconstrução de Kruskal. Nos dois casos as consultas
+// usam LCA offline de Tarjan, em O(E α(V)).
+class VerificadorOtimalidade {
+public:
+    // Certificado da última resolução de Tarjan/Gabow feita com 'espaco'
+    static CertificadoArborescencia certificado(const EspacoTrabalhoArborescencia& espaco);
+
+    static ResultadoVerificacao verificarArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz,
+                                                       const std::vector<Aresta>& arvore,
+                                                       const CertificadoArborescencia& cert);
+
+    // 'arestas' são as arestas não direcionadas do grafo (n vértices); 'arvore' deve
+    // ser uma floresta geradora máxima (uma árvore por componente)
+    static ResultadoVerificacao verificarMST(int n, const std::vector<Aresta>& arestas, const std::vector<Aresta>& arvore);
+};
+
+#endif
@@ -5,37 +5,149 @@
 #include <vector>
 #include <list>
 #include <utility>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <atomic>
 
 struct Aresta {
     int origem;
     int destino;
     double peso;
-    int idOriginal; 
-    
-    Aresta(int u, int v, double p, int id = -1) 
+    int idOriginal;
+
+    Aresta(int u, int v, double p, int id = -1)
         : origem(u), destino(v), peso(p), idOriginal(id) {}
 };
 
+// Arcos vistos pelos algoritmos direcionados, de 0 a size()-1. Num grafo
+// simétrico cada aresta guardada k = {u, v} gera dois arcos: 2k (u -> v) e
+// 2k+1 (v -> u); nos demais o arco i é a aresta i. A conversão implícita de
+// um vetor de arestas permite passar vetores onde se espera a visão.
+class IteradorArcos;
+
+class VisaoArcos {
+public:
+    VisaoArcos(const std::vector<Aresta>& arestas) : base(arestas.data()), numArestas(arestas.size()), simetrico(false) {}
+    VisaoArcos(const Aresta* base, size_t numArestas, bool simetrico) : base(base), numArestas(numArestas), simetrico(simetrico) {}
+
+    size_t size() const { return simetrico ? 2 * numArestas : numArestas; }
+    bool empty() const { return numArestas == 0; }
+
+    Aresta operator[](size_t i) const {
+        if (!simetrico) return base[i];
+        const Aresta& a = base[i >> 1];
+        return (i & 1) ? Aresta(a.destino, a.origem, a.peso, a.idOriginal) : a;
+    }
+
+    IteradorArcos begin() const;
+    IteradorArcos end() const;
+
+private:
+    const Aresta* base;
+    size_t numArestas;
+    bool simetrico;
+};
+
+class IteradorArcos {
+public:
+    IteradorArcos(const VisaoArcos& arcos, size_t i) : arcos(arcos), i(i) {}
+    Aresta operator*() const { return arcos[i]; }
+    IteradorArcos& operator++() { ++i; return *this; }
+    bool operator!=(const IteradorArcos& o) const { return i != o.i; }
+    bool operator==(const IteradorArcos& o) const { return i == o.i; }
+private:
+    VisaoArcos arcos;
+    size_t i;
+};
+
+inline IteradorArcos VisaoArcos::begin() const { return IteradorArcos(*this, 0); }
+inline IteradorArcos VisaoArcos::end() const { return IteradorArcos(*this, size()); }
+
+// Visão dos arcos de um vértice: posições em getArcos(), sem cópia
+class FaixaArestas {
+public:
+    class iterador {
+    public:
+        iterador(const VisaoArcos& arcos, const int* pos) : arcos(arcos), pos(pos) {}
+        Aresta operator*() const { return arcos[*pos]; }
+        iterador& operator++() { ++pos; return *this; }
+        bool operator!=(const iterador& o) const { return pos != o.pos; }
+        bool operator==(const iterador& o) const { return pos == o.pos; }
+    private:
+        VisaoArcos arcos;
+        const int* pos;
+    };
+
+    FaixaArestas(const VisaoArcos& arcos, const int* inicio, const int* fim) : arcos(arcos), inicio(inicio), fim(fim) {}
+
+    iterador begin() const { return iterador(arcos, inicio); }
+    iterador end() const { return iterador(arcos, fim); }
+    size_t size() const { return fim - inicio; }
+    bool empty() const { return inicio == fim; }
+
+private:
+    VisaoArcos arcos;
+    const int* inicio;
+    const int* fim;
+};
+
 class GrafoDirecionadoPonderado : public GrafoDirecionado
 {
 protected:
-    std::vector<std::list<std::pair<int, double>>> adjPeso;
-    std::vector<std::list<Aresta>> adjEntrada;
     std::vector<Aresta> todasArestas;
+    bool simetrico = false;  // Cada aresta guardada vale nos dois sentidos (ver VisaoArcos)
+
+    // Adjacência em CSR: posições de getArcos() agrupadas por origem e por
+    // destino. Montada com um counting sort (tamanho exato) no primeiro acesso,
+    // sob std::call_once, de modo que leituras concorrentes do mesmo grafo são
+    // seguras. Cópias compartilham os índices até que uma delas receba uma
+    // aresta; os algoritmos usam apenas getArcos().
+    struct IndicesAdjacencia {
+        std::once_flag montagem;
+        std::atomic<bool> montados{false};
+        std::vector<int> inicioSaida, posSaida, inicioEntrada, posEntrada;
+    };
+    std::shared_ptr<IndicesAdjacencia> indices = std::make_shared<IndicesAdjacencia>();
+    std::vector<char> entradaRemovida; // removerArestasEntrada (vazio: nenhuma)
+
+    const IndicesAdjacencia& obterIndices() const;
 
 public:
     GrafoDirecionadoPonderado(int vertices);
 
+    // Construção em bloco: assume o vetor de arestas (sem cópia e sem
+    // adicionarAresta por aresta). Lança std::out_of_range se algum extremo
+    // estiver fora de [0, vertices).
+    GrafoDirecionadoPonderado(int vertices, std::vector<Aresta>&& arestas);
+
+    // Construção em bloco a partir de vetores paralelos (mesmo tamanho, lança
+    // std::invalid_argument se não forem), com a mesma verificação de extremos
+    GrafoDirecionadoPonderado(int vertices, const std::vector<int>& origens, const std::vector<int>& destinos,
+                              const std::vector<double>& pesos);
+
+    // Reserva espaço para 'numArestas' arestas antes de uma sequência de adicionarAresta
+    void reservarArestas(size_t numArestas);
+
     void adicionarAresta(int v1, int v2, double peso);
-    
-    using GrafoDirecionado::adicionarAresta; 
+
+    using GrafoDirecionado::adicionarAresta;
 
     void imprimirGrafo() const override;
-    
-    const std::list<Aresta>& getArestasEntrada(int v) const;
+
+    FaixaArestas getArestasEntrada(int v) const;
+    FaixaArestas getArestasSaida(int v) const;
+
+    // Arestas guardadas: num grafo simétrico, uma por par de vértices
     const std::vector<Aresta>& getTodasArestas() const;
-    
+
+    // Arcos consumidos pelos algoritmos direcionados; os índices das
+    // arborescências (encontrarArestasArborescencia) se referem a eles
+    VisaoArcos getArcos() const { return VisaoArcos(todasArestas.data(), todasArestas.size(), simetrico); }
+    size_t numArcos() const { return simetrico ? 2 * todasArestas.size() : todasArestas.size(); }
+    bool ehSimetrico() const { return simetrico; }
+
     void removerArestasEntrada(int v);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -3,14 +3,20 @@
 
 #include "grafoDirecionadoPonderado.h"
 
+// Grafo simétrico: cada aresta {u, v} é guardada uma única vez e aparece
+// nos dois sentidos em getArcos() e nas faixas de saída/entrada, de modo
+// que os algoritmos direcionados o consomem sem conversão.
 class GrafoNaoDirecionadoPonderado : public GrafoDirecionadoPonderado {
 public:
     explicit GrafoNaoDirecionadoPonderado(int vertices);
 
+    // Construção em bloco; cada aresta aparece uma única vez
+    GrafoNaoDirecionadoPonderado(int vertices, std::vector<Aresta>&& arestas);
+
     using GrafoDirecionadoPonderado::adicionarAresta; 
 
     void adicionarAresta(int v1, int v2, double peso);
     void imprimirGrafo() const override;
 };
 
-#endif
\ No newline at end of file
+#endif
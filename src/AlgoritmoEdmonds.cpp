@@ -1,4 +1,5 @@
 #include "AlgoritmoEdmonds.h"
+#include "Rastreamento.h"
 #include <limits>
 #include <iostream>
 #include <map>
@@ -6,24 +7,46 @@
 
 using namespace std;
 
-GrafoDirecionadoPonderado AlgoritmoEdmonds::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz) {
+GrafoDirecionadoPonderado AlgoritmoEdmonds::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz,
+                                                                        EstatisticasSolver* estatisticas) {
     vector<int> vertices(grafo.numVertices());
     for(int i=0; i < grafo.numVertices(); ++i) vertices[i] = i;
 
-    vector<Aresta> todasArestas = grafo.getTodasArestas();
+    EscopoRastro rastroCopia("edmonds:arestas");
+    const VisaoArcos arcos = grafo.getArcos();
+    vector<Aresta> todasArestas;
+    todasArestas.reserve(arcos.size());
+    for (const auto& a : arcos) todasArestas.push_back(a);
+    rastroCopia.encerrar();
+
+    // Chamada do método recursivo (contração e expansão intercaladas por nível)
+    EscopoRastro rastroRecursao("edmonds:recursao");
+    list<Aresta> arborescenciaArestas;
+    vector<int> aninhamento;
+    if (estatisticas) {
+        *estatisticas = EstatisticasSolver();
+        aninhamento.assign(grafo.numVertices(), 0);
+        arborescenciaArestas = edmondsRecursivo(vertices, todasArestas, raiz, ColetorEstatisticas<true>(estatisticas), 1, aninhamento);
+    } else {
+        arborescenciaArestas = edmondsRecursivo(vertices, todasArestas, raiz, ColetorEstatisticas<false>(), 1, aninhamento);
+    }
 
-    // Chamada do método recursivo
-    list<Aresta> arborescenciaArestas = edmondsRecursivo(vertices, todasArestas, raiz);
+    rastroRecursao.encerrar();
 
-    // Monta o grafo de resultado
-    GrafoDirecionadoPonderado resultado(grafo.numVertices());
+    // Monta o grafo de resultado (em bloco, tamanho exato)
+    EscopoRastro rastroMontagem("edmonds:montagem");
+    vector<Aresta> arestas;
+    arestas.reserve(arborescenciaArestas.size());
     for(const auto& aresta : arborescenciaArestas) {
-        resultado.adicionarAresta(aresta.origem, aresta.destino, aresta.peso);
+        arestas.emplace_back(aresta.origem, aresta.destino, aresta.peso);
     }
-    return resultado;
+    return GrafoDirecionadoPonderado(grafo.numVertices(), std::move(arestas));
 }
 
-std::list<Aresta> AlgoritmoEdmonds::edmondsRecursivo(const std::vector<int>& vertices, const std::vector<Aresta>& arestas, int raiz) {
+template <bool ComEstatisticas>
+std::list<Aresta> AlgoritmoEdmonds::edmondsRecursivo(const std::vector<int>& vertices, const std::vector<Aresta>& arestas, int raiz,
+                                                     ColetorEstatisticas<ComEstatisticas> coletor, int nivel, std::vector<int>& aninhamento) {
+    coletor.recursao(nivel);
 
     // Caso base: grafo vazio ou apenas a raiz
     if (vertices.empty() || (vertices.size() == 1 && vertices[0] == raiz)) {
@@ -115,6 +138,14 @@ std::list<Aresta> AlgoritmoEdmonds::edmondsRecursivo(const std::vector<int>& ver
     }
 
     // 3. Contração do Ciclo (Recursão)
+    coletor.ciclo();
+    if constexpr (ComEstatisticas) {
+        int profundidade = 0;
+        for (int v : cicloDetectado) profundidade = max(profundidade, aninhamento[v]);
+        aninhamento[novoIdCiclo] = profundidade + 1;
+        coletor.aninhamento(profundidade + 1);
+    }
+
     vector<int> novosVertices;
     for(int v : vertices) {
         if (grupo[v] == -1) { 
@@ -155,11 +186,15 @@ std::list<Aresta> AlgoritmoEdmonds::edmondsRecursivo(const std::vector<int>& ver
             nova.peso = novoPeso;
             novasArestas.push_back(nova);
         }
+        else {
+            // Interna ao ciclo: vira auto-laço do supernó
+            coletor.lacosDescartados();
+        }
     }
 
     // Chama recursão
     int novaRaiz = (grupo[raiz] != -1) ? novoIdCiclo : raiz;
-    list<Aresta> arborescenciaContraida = edmondsRecursivo(novosVertices, novasArestas, novaRaiz);
+    list<Aresta> arborescenciaContraida = edmondsRecursivo(novosVertices, novasArestas, novaRaiz, coletor, nivel + 1, aninhamento);
 
     // 4. Expansão (Recupera o grafo original)
     list<Aresta> resultadoFinal;
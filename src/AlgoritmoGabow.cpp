@@ -1,121 +1,75 @@
 #include "AlgoritmoGabow.h"
+#include "Rastreamento.h"
 #include <vector>
 #include <algorithm>
-#include <stack>
 #include <limits>
 
 using namespace std;
 
-// Nó do Skew Heap 
-struct GabowNode {
-    double val;       // Peso da aresta
-    double lazy;      // Valor para propagação preguiçosa
-    int u, v;         // Origem e Destino
-    int idOriginal;   // Índice original
-    GabowNode *left, *right;
-
-    GabowNode(double w, int _u, int _v, int _id) 
-        : val(w), lazy(0), u(_u), v(_v), idOriginal(_id), left(nullptr), right(nullptr) {}
-};
-
-// Gerenciador de memória
-static std::vector<GabowNode*> nodePool;
-
-GabowNode* novoNo(double w, int u, int v, int id) {
-    GabowNode* node = new GabowNode(w, u, v, id);
-    nodePool.push_back(node);
-    return node;
-}
-
-// Propaga valor lazy
-void gabow_push_lazy(GabowNode* t) {
-    if (!t || t->lazy == 0) return;
-    t->val += t->lazy;
-    if (t->left) t->left->lazy += t->lazy;
-    if (t->right) t->right->lazy += t->lazy;
-    t->lazy = 0;
+// Algoritmo Principal
+template <class Heap>
+GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz) {
+    EspacoTrabalhoArborescencia espaco;
+    return encontrarArborescenciaMinima<Heap>(grafo, raiz, espaco);
 }
 
-// Fusão de dois Skew Heaps
-GabowNode* gabow_merge(GabowNode* a, GabowNode* b) {
-    gabow_push_lazy(a);
-    gabow_push_lazy(b);
-    if (!a) return b;
-    if (!b) return a;
-    if (a->val > b->val) swap(a, b); 
-    swap(a->left, a->right);
-    a->left = gabow_merge(b, a->left);
-    return a;
+template <class Heap>
+GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                                              EstatisticasSolver* estatisticas) {
+    const VisaoArcos arcos = grafo.getArcos();
+    const vector<int>& escolhidas = estatisticas ? encontrarArestasArborescencia<Heap>(grafo, raiz, espaco, *estatisticas)
+                                                 : encontrarArestasArborescencia<Heap>(grafo, raiz, espaco);
+
+    // Monta o grafo de resultado (em bloco, tamanho exato)
+    EscopoRastro rastro("gabow:montagem");
+    vector<Aresta> arestas;
+    arestas.reserve(escolhidas.size());
+    for (int edgeID : escolhidas) {
+        const auto& aresta = arcos[edgeID];
+        arestas.emplace_back(aresta.origem, aresta.destino, aresta.peso);
+    }
+    return GrafoDirecionadoPonderado(grafo.numVertices(), std::move(arestas));
 }
 
-GabowNode* gabow_push(GabowNode* root, double w, int u, int v, int id) {
-    return gabow_merge(root, novoNo(w, u, v, id));
+template <class Heap>
+const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco) {
+    return resolver<Heap, false>(grafo, raiz, espaco, ColetorEstatisticas<false>());
 }
 
-GabowNode* gabow_pop(GabowNode* root) {
-    gabow_push_lazy(root);
-    return gabow_merge(root->left, root->right);
+template <class Heap>
+const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                                        EstatisticasSolver& estatisticas) {
+    estatisticas = EstatisticasSolver();
+    return resolver<Heap, true>(grafo, raiz, espaco, ColetorEstatisticas<true>(&estatisticas));
 }
 
-
-// Estrutura Union-Find
-// DSU Local: Optou-se por uma implementacao dedicada ao inves da classe UnionFind.h
-// pois o algoritmo de Gabow exige uma politica de uniao especifica (o novo supernoDEVE ser o pai), 
-// o que e incompativel com a otimizacao 'Union by Rank' generica.
-struct DSU {
-    vector<int> pai;
-    DSU(int n) {
-        pai.resize(n);
-        for(int i=0; i<n; ++i) pai[i] = i;
-    }
-    int find(int i) {
-        return (pai[i] == i) ? i : (pai[i] = find(pai[i]));
-    }
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if(root_i != root_j) pai[root_i] = root_j;
-    }
-};
-
-// Estruturas para reconstrução
-struct ComponenteCiclo {
-    int representante; 
-    int edgeID;        
-};
-
-struct CicloInfo {
-    int superNo; 
-    vector<ComponenteCiclo> componentes; 
-};
-
-// Algoritmo Principal
-GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz) {
+template <class Heap, bool ComEstatisticas>
+const vector<int>& AlgoritmoGabow::resolver(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                   ColetorEstatisticas<ComEstatisticas> coletor) {
     int n = grafo.numVertices();
-    const auto& todasArestas = grafo.getTodasArestas();
-    
-    // Limpa memória de execuções anteriores
-    for(auto p : nodePool) delete p;
-    nodePool.clear();
-
-    // Inicialização das heaps
-    vector<GabowNode*> queues(2 * n, nullptr); 
-    
-    for (size_t i = 0; i < todasArestas.size(); ++i) {
-        const auto& aresta = todasArestas[i];
-        if (aresta.destino == raiz || aresta.origem == aresta.destino) continue;
-        queues[aresta.destino] = gabow_push(queues[aresta.destino], aresta.peso, aresta.origem, aresta.destino, (int)i);
-    }
-
-    DSU dsu(2 * n);
-    vector<int> estado(2 * n, 0); // 0: novo, 1: ativo, 2: processado
-    vector<int> arestaEntradaEscolhida(2 * n, -1); 
-    vector<int> paiNaHierarquia(2 * n, -1); 
-    stack<CicloInfo> pilhaCiclos;
+    const VisaoArcos arcos = grafo.getArcos();
+
+    EscopoRastro rastroHeaps("gabow:heaps");
+    espaco.preparar(n, arcos.size());
+
+    // Inicialização das heaps (agrupamento por destino, tempo linear)
+    Heap queues(espaco);
+    queues.construir(arcos, n, raiz);
+    coletor.nosHeap(espaco.numNosHeap());
+    rastroHeaps.encerrar();
+
+    // DSU dedicada: o novo supernó DEVE ser o pai (ver DSUSupernos)
+    DSUSupernos dsu(espaco.dsuPai);
+    vector<int>& estado = espaco.marca;
+    estado.assign(2 * n, 0); // 0: novo, 1: ativo, 2: processado
+    vector<int>& arestaEntradaEscolhida = espaco.arestaEntradaEscolhida; 
+    vector<double>& pesoEntradaEscolhida = espaco.pesoEntradaEscolhida;
+    vector<int>& paiNaHierarquia = espaco.paiNaHierarquia; 
     
     int numComponentes = n; 
 
     // Fase de Contração (Path Growing)
+    EscopoRastro rastroContracao("gabow:contracao");
     for (int i = 0; i < n; ++i) {
         if (i == raiz) continue; 
         
@@ -127,10 +81,13 @@ GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima(GrafoDire
             estado[curr] = 1; 
 
             // Remove auto-loops
-            GabowNode* minNode = queues[curr];
+            double peso = 0;
+            NoHeap* minNode = queues.minimo(curr, peso);
             while (minNode && dsu.find(minNode->u) == curr) {
-                queues[curr] = gabow_pop(queues[curr]);
-                minNode = queues[curr];
+                queues.removerMinimo(curr);
+                coletor.remocao();
+                coletor.lacosDescartados();
+                minNode = queues.minimo(curr, peso);
             }
 
             if (!minNode) {
@@ -140,44 +97,30 @@ GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima(GrafoDire
 
             // Seleciona provisoriamente esta aresta
             arestaEntradaEscolhida[curr] = minNode->idOriginal;
+            pesoEntradaEscolhida[curr] = peso;
             int origem = dsu.find(minNode->u);
 
             if (estado[origem] == 1) {
                 // Ciclo detectado
                 int novoSuperNo = numComponentes++;
-                CicloInfo ciclo;
-                ciclo.superNo = novoSuperNo;
+                coletor.ciclo();
 
-                GabowNode* heapUniao = nullptr;
-                
-                // Funde componentes do ciclo
+                // Funde componentes do ciclo, percorrendo as arestas escolhidas
+                // de volta até retornar ao componente atual
                 int iter = curr;
-                while (iter != origem) {
+                do {
                     int edgeId = arestaEntradaEscolhida[iter];
-                    ciclo.componentes.push_back({iter, edgeId});
                     paiNaHierarquia[iter] = novoSuperNo;
                     
-                    // Merge do heap com ajuste lazy
-                    GabowNode* h = queues[iter];
-                    if(h) h->lazy -= todasArestas[edgeId].peso;
-                    heapUniao = gabow_merge(heapUniao, h);
+                    // Merge do heap com ajuste lazy (peso reduzido da aresta escolhida)
+                    queues.somar(iter, -pesoEntradaEscolhida[iter]);
+                    queues.fundir(novoSuperNo, iter);
+                    coletor.fusao();
                     
                     dsu.unite(iter, novoSuperNo);
-                    iter = dsu.find(todasArestas[edgeId].origem);
-                }
-                
-                // Trata o nó de fechamento
-                int edgeIdOrigem = minNode->idOriginal;
-                ciclo.componentes.push_back({origem, edgeIdOrigem});
-                paiNaHierarquia[origem] = novoSuperNo;
-                
-                GabowNode* h = queues[origem];
-                if(h) h->lazy -= todasArestas[edgeIdOrigem].peso;
-                heapUniao = gabow_merge(heapUniao, h);
-                dsu.unite(origem, novoSuperNo);
-                
-                pilhaCiclos.push(ciclo);
-                queues[novoSuperNo] = heapUniao;
+                    iter = dsu.find(arcos[edgeId].origem);
+                } while (iter != novoSuperNo);
+
                 estado[novoSuperNo] = 1; 
                 
                 curr = novoSuperNo;
@@ -193,52 +136,42 @@ GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima(GrafoDire
             estado[temp] = 2;
             if (temp == raiz || arestaEntradaEscolhida[temp] == -1) break;
             
-            int parent = dsu.find(todasArestas[arestaEntradaEscolhida[temp]].origem);
+            int parent = dsu.find(arcos[arestaEntradaEscolhida[temp]].origem);
             if (parent == temp) break; 
             temp = parent;
         }
     }
 
-    // Fase de Expansão
-    while (!pilhaCiclos.empty()) {
-        CicloInfo ciclo = pilhaCiclos.top();
-        pilhaCiclos.pop();
-        
-        int superNo = ciclo.superNo;
-        int arestaQueEntraNoSuperNo = arestaEntradaEscolhida[superNo];
-        
-        int subComponenteEntrada = -1;
-        
-        if (arestaQueEntraNoSuperNo != -1) {
-            int destinoReal = todasArestas[arestaQueEntraNoSuperNo].destino;
-            
-            int temp = destinoReal;
-            while (paiNaHierarquia[temp] != superNo && paiNaHierarquia[temp] != -1) {
-                temp = paiNaHierarquia[temp];
-            }
-            subComponenteEntrada = temp;
-        }
-        
-        // Resolve arestas internas
-        for (const auto& comp : ciclo.componentes) {
-            if (comp.representante == subComponenteEntrada) {
-                arestaEntradaEscolhida[comp.representante] = arestaQueEntraNoSuperNo;
-            } else {
-                arestaEntradaEscolhida[comp.representante] = comp.edgeID;
-            }
-        }
-    }
+    rastroContracao.encerrar();
+    coletor.hierarquia(paiNaHierarquia, numComponentes);
+
+    // Fase de Expansão: uma passada de cima para baixo na hierarquia
+    EscopoRastro rastroExpansao("gabow:expansao");
+    espaco.expandirHierarquia(arcos, numComponentes, n, raiz);
 
-    // Monta o grafo de resultado
-    GrafoDirecionadoPonderado resultado(n);
+    // Arestas escolhidas para os vértices originais
     for (int i = 0; i < n; ++i) {
-        if (i == raiz) continue;
-        int edgeID = arestaEntradaEscolhida[i];
-        if (edgeID != -1) {
-            const auto& aresta = todasArestas[edgeID];
-            resultado.adicionarAresta(aresta.origem, aresta.destino, aresta.peso);
-        }
+        int edgeID = espaco.entradaVertice[i];
+        if (edgeID != -1) espaco.arestasEscolhidas.push_back(edgeID);
     }
 
-    return resultado;
+    return espaco.arestasEscolhidas;
 }
+
+// Instâncias das políticas disponíveis na CLI
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapSkew>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapLeftist>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapPairing>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapRadix>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapSkew>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapLeftist>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapPairing>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template GrafoDirecionadoPonderado AlgoritmoGabow::encontrarArborescenciaMinima<HeapRadix>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapSkew>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapLeftist>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapPairing>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapRadix>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapSkew>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapLeftist>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapPairing>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
+template const vector<int>& AlgoritmoGabow::encontrarArestasArborescencia<HeapRadix>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
@@ -1,31 +1,38 @@
 #include "AlgoritmoKruskal.h"
+#include "Rastreamento.h"
 #include <algorithm>
 #include <vector>
 
 GrafoNaoDirecionadoPonderado AlgoritmoKruskal::encontrarMST(GrafoNaoDirecionadoPonderado& grafo) {
     int V = grafo.numVertices();
-    GrafoNaoDirecionadoPonderado mst(V);
     
     // Obtém todas as arestas
+    EscopoRastro rastroOrdenacao("kruskal:ordenacao");
     std::vector<Aresta> arestas = grafo.getTodasArestas();
 
     // Ordena as arestas por peso crescente
     std::sort(arestas.begin(), arestas.end(), [](const Aresta& a, const Aresta& b) {
         return a.peso < b.peso;
     });
+    rastroOrdenacao.encerrar();
 
+    return encontrarMST(V, arestas);
+}
+
+GrafoNaoDirecionadoPonderado AlgoritmoKruskal::encontrarMST(int V, const std::vector<Aresta>& arestas) {
     // Inicializa Union-Find
+    EscopoRastro rastroUniao("kruskal:uniao");
     UnionFind uf(V);
-    int arestasAdicionadas = 0;
+    std::vector<Aresta> arestasMST;
+    arestasMST.reserve(V > 0 ? V - 1 : 0); // Uma floresta tem no máximo V-1 arestas
 
     for (const auto& aresta : arestas) {
         // Verifica se a aresta forma ciclo
         if (uf.find(aresta.origem) != uf.find(aresta.destino)) {
             uf.unite(aresta.origem, aresta.destino);
-            mst.adicionarAresta(aresta.origem, aresta.destino, aresta.peso);
-            arestasAdicionadas++;
+            arestasMST.emplace_back(aresta.origem, aresta.destino, aresta.peso);
         }
     }
 
-    return mst;
+    return GrafoNaoDirecionadoPonderado(V, std::move(arestasMST));
 }
\ No newline at end of file
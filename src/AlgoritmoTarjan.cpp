@@ -1,119 +1,75 @@
 #include "AlgoritmoTarjan.h"
+#include "Rastreamento.h"
 #include <vector>
 #include <iostream>
 #include <algorithm>
-#include <stack>
 
 using namespace std;
 
-// Gerenciador de memória
-static std::vector<struct HeapNode*> nodesAllocated;
-
-// Nó da Skew Heap
-struct HeapNode {
-    double val;          // Peso ajustado
-    double lazy;         // Valor para propagação preguiçosa
-    int u, v;            // Aresta
-    int idOriginal;      // ID original para recuperação
-    HeapNode *left, *right;
-
-    HeapNode(double w, int _u, int _v, int _id) 
-        : val(w), lazy(0), u(_u), v(_v), idOriginal(_id), left(nullptr), right(nullptr) {
-            nodesAllocated.push_back(this);
-        }
-};
-
-// Estruturas para reconstrução
-struct ComponenteCiclo {
-    int representante; 
-    int edgeID;        
-};
-
-struct CicloInfo {
-    int superNo; 
-    vector<ComponenteCiclo> componentes; 
-};
-
-// Funções de Heap (Skew Heap)
-
-void push_lazy(HeapNode* t) {
-    if (!t || t->lazy == 0) return;
-    t->val += t->lazy;
-    if (t->left) t->left->lazy += t->lazy;
-    if (t->right) t->right->lazy += t->lazy;
-    t->lazy = 0;
+// Implementação Principal
+template <class Heap>
+GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz) {
+    EspacoTrabalhoArborescencia espaco;
+    return encontrarArborescenciaMinima<Heap>(grafo, raiz, espaco);
 }
 
-HeapNode* merge(HeapNode* a, HeapNode* b) {
-    push_lazy(a);
-    push_lazy(b);
-    if (!a) return b;
-    if (!b) return a;
-    
-    if (a->val > b->val) swap(a, b);
-    
-    swap(a->left, a->right); 
-    a->left = merge(b, a->left);
-    return a;
+template <class Heap>
+GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                                              EstatisticasSolver* estatisticas) {
+    const VisaoArcos arcos = grafo.getArcos();
+    const vector<int>& escolhidas = estatisticas ? encontrarArestasArborescencia<Heap>(grafo, raiz, espaco, *estatisticas)
+                                                 : encontrarArestasArborescencia<Heap>(grafo, raiz, espaco);
+
+    // Construção do Grafo Final (em bloco, tamanho exato)
+    EscopoRastro rastro("tarjan:montagem");
+    vector<Aresta> arestas;
+    arestas.reserve(escolhidas.size());
+    for (int edgeID : escolhidas) {
+        const auto& aresta = arcos[edgeID];
+        arestas.emplace_back(aresta.origem, aresta.destino, aresta.peso);
+    }
+    return GrafoDirecionadoPonderado(grafo.numVertices(), std::move(arestas));
 }
 
-HeapNode* push(HeapNode* root, double w, int u, int v, int id) {
-    return merge(root, new HeapNode(w, u, v, id));
+template <class Heap>
+const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco) {
+    return resolver<Heap, false>(grafo, raiz, espaco, ColetorEstatisticas<false>());
 }
 
-HeapNode* pop(HeapNode* root) {
-    push_lazy(root);
-    return merge(root->left, root->right);
+template <class Heap>
+const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                                        EstatisticasSolver& estatisticas) {
+    estatisticas = EstatisticasSolver();
+    return resolver<Heap, true>(grafo, raiz, espaco, ColetorEstatisticas<true>(&estatisticas));
 }
 
-// Union-Find 
-// DSU Local: Assim como no algoritmo de Gabow, optou-se por uma DSU dedicada.
-// O gerenciamento das filas de prioridade (vetor 'heaps') depende estritamente
-// do identificador do representante do conjunto. O uso de Union-By-Rank generico
-// poderia alterar o representante imprevisivelmente, quebrando o mapeamento das heaps.
-struct DSU {
-    vector<int> pai;
-    DSU(int n) {
-        pai.resize(n);
-        for(int i=0; i<n; ++i) pai[i] = i;
-    }
-    int find(int i) {
-        if(pai[i] == i) return i;
-        return pai[i] = find(pai[i]);
-    }
-    void unite(int i, int j) {
-        int root_i = find(i);
-        int root_j = find(j);
-        if(root_i != root_j) pai[root_i] = root_j;
-    }
-};
-
-// Implementação Principal
-GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima(GrafoDirecionadoPonderado& grafo, int raiz) {
+template <class Heap, bool ComEstatisticas>
+const vector<int>& AlgoritmoTarjan::resolver(const GrafoDirecionadoPonderado& grafo, int raiz, EspacoTrabalhoArborescencia& espaco,
+                                   ColetorEstatisticas<ComEstatisticas> coletor) {
     int n = grafo.numVertices();
-    const auto& todasArestas = grafo.getTodasArestas();
-    
-    // Limpeza de memória
-    nodesAllocated.clear(); 
-
-    // Inicialização das heaps
-    vector<HeapNode*> heaps(2 * n, nullptr); 
-    
-    for (size_t i = 0; i < todasArestas.size(); ++i) {
-        const auto& aresta = todasArestas[i];
-        if (aresta.destino == raiz || aresta.origem == aresta.destino) continue;
-        heaps[aresta.destino] = push(heaps[aresta.destino], aresta.peso, aresta.origem, aresta.destino, (int)i);
-    }
-
-    DSU dsu(2 * n);
-    vector<int> visitado(2 * n, -1);
-    vector<int> arestaEntradaEscolhida(2 * n, -1); 
-    vector<int> paiNaHierarquia(2 * n, -1); 
-    stack<CicloInfo> pilhaCiclos;
+    const VisaoArcos arcos = grafo.getArcos();
+
+    EscopoRastro rastroHeaps("tarjan:heaps");
+    espaco.preparar(n, arcos.size());
+
+    // Inicialização das heaps (agrupamento por destino, tempo linear)
+    Heap heaps(espaco);
+    heaps.construir(arcos, n, raiz);
+    coletor.nosHeap(espaco.numNosHeap());
+    rastroHeaps.encerrar();
+
+    // DSU dedicada: o gerenciamento das filas de prioridade depende estritamente
+    // do identificador do representante do conjunto (ver DSUSupernos)
+    DSUSupernos dsu(espaco.dsuPai);
+    vector<int>& visitado = espaco.marca;
+    vector<int>& arestaEntradaEscolhida = espaco.arestaEntradaEscolhida; 
+    vector<double>& pesoEntradaEscolhida = espaco.pesoEntradaEscolhida;
+    vector<int>& paiNaHierarquia = espaco.paiNaHierarquia; 
     
     int numComponentes = n; 
 
     // Fase de Contração
+    EscopoRastro rastroContracao("tarjan:contracao");
     for (int i = 0; i < n; ++i) {
         if (i == raiz) continue;
 
@@ -123,56 +79,48 @@ GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima(GrafoDir
         while (visitado[curr] == -1 && curr != dsu.find(raiz)) {
             visitado[curr] = i; 
 
-            if (!heaps[curr]) {
-                break; // Componente inalcançável
-            }
-
             // Remove auto-loops
-            HeapNode* minEdge = heaps[curr];
+            double peso = 0;
+            NoHeap* minEdge = heaps.minimo(curr, peso);
             while (minEdge && dsu.find(minEdge->u) == curr) {
-                heaps[curr] = pop(heaps[curr]);
-                minEdge = heaps[curr];
+                heaps.removerMinimo(curr);
+                coletor.remocao();
+                coletor.lacosDescartados();
+                minEdge = heaps.minimo(curr, peso);
             }
 
-            if (!minEdge) break;
+            if (!minEdge) break; // Componente inalcançável
 
             // Seleciona provisoriamente esta aresta
             arestaEntradaEscolhida[curr] = minEdge->idOriginal;
+            pesoEntradaEscolhida[curr] = peso;
             
             int origem = dsu.find(minEdge->u);
 
             if (visitado[origem] == i) {
                 // Ciclo detectado
                 int novoSuperNo = numComponentes++;
-                CicloInfo ciclo;
-                ciclo.superNo = novoSuperNo;
-                
-                HeapNode* heapUniao = nullptr;
+                coletor.ciclo();
                 int iter = curr;
                 
-                // Funde heaps do ciclo e salva info
-                while (true) {
+                // Funde heaps do ciclo e salva info, percorrendo as arestas
+                // escolhidas de volta até retornar ao componente atual
+                do {
                     int edgeId = arestaEntradaEscolhida[iter];
-                    ciclo.componentes.push_back({iter, edgeId});
                     paiNaHierarquia[iter] = novoSuperNo;
 
-                    // Merge com lazy update
-                    HeapNode* h = heaps[iter];
-                    if (h) h->lazy -= todasArestas[edgeId].peso;
-                    heapUniao = merge(heapUniao, h);
+                    // Merge com lazy update (peso reduzido da aresta escolhida)
+                    heaps.somar(iter, -pesoEntradaEscolhida[iter]);
+                    heaps.fundir(novoSuperNo, iter);
+                    coletor.fusao();
 
                     dsu.unite(iter, novoSuperNo);
-
-                    if (iter == origem) break;
                     
                     // Avança no ciclo
-                    iter = dsu.find(todasArestas[edgeId].origem);
-                }
+                    iter = dsu.find(arcos[edgeId].origem);
+                } while (iter != novoSuperNo);
 
                 // Finaliza supernó
-                heaps[novoSuperNo] = heapUniao;
-                pilhaCiclos.push(ciclo);
-                
                 curr = novoSuperNo;
                 visitado[curr] = -1; // Permite revisitar o supernó
                 
@@ -183,52 +131,36 @@ GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima(GrafoDir
         }
     }
 
-    // Fase de Expansão
-    while (!pilhaCiclos.empty()) {
-        CicloInfo ciclo = pilhaCiclos.top();
-        pilhaCiclos.pop();
-        
-        int superNo = ciclo.superNo;
-        int arestaQueEntraNoSuperNo = arestaEntradaEscolhida[superNo];
-        
-        int subComponenteEntrada = -1;
-        
-        // Encontra o sub-componente real dentro do super-nó
-        if (arestaQueEntraNoSuperNo != -1) {
-            int destinoReal = todasArestas[arestaQueEntraNoSuperNo].destino;
-            int temp = destinoReal;
-            
-            while (paiNaHierarquia[temp] != superNo && paiNaHierarquia[temp] != -1) {
-                temp = paiNaHierarquia[temp];
-            }
-            subComponenteEntrada = temp;
-        }
-        
-        // Distribui as arestas internas e externas
-        for (const auto& comp : ciclo.componentes) {
-            if (comp.representante == subComponenteEntrada) {
-                arestaEntradaEscolhida[comp.representante] = arestaQueEntraNoSuperNo;
-            } else {
-                arestaEntradaEscolhida[comp.representante] = comp.edgeID;
-            }
-        }
-    }
+    rastroContracao.encerrar();
+    coletor.hierarquia(paiNaHierarquia, numComponentes);
+
+    // Fase de Expansão: uma passada de cima para baixo na hierarquia
+    EscopoRastro rastroExpansao("tarjan:expansao");
+    espaco.expandirHierarquia(arcos, numComponentes, n, raiz);
 
-    // Construção do Grafo Final
-    GrafoDirecionadoPonderado resultado(n);
+    // Arestas escolhidas para os vértices originais
     for (int i = 0; i < n; ++i) {
-        if (i == raiz) continue;
-        
-        int edgeID = arestaEntradaEscolhida[i];
-        if (edgeID != -1) {
-            const auto& aresta = todasArestas[edgeID];
-            resultado.adicionarAresta(aresta.origem, aresta.destino, aresta.peso);
-        }
+        int edgeID = espaco.entradaVertice[i];
+        if (edgeID != -1) espaco.arestasEscolhidas.push_back(edgeID);
     }
 
-    // Limpeza de memória
-    for(auto p : nodesAllocated) delete p;
-    nodesAllocated.clear();
-
-    return resultado;
+    return espaco.arestasEscolhidas;
 }
+
+// Instâncias das políticas disponíveis na CLI
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapSkew>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapLeftist>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapPairing>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapRadix>(GrafoDirecionadoPonderado&, int);
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapSkew>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapLeftist>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapPairing>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template GrafoDirecionadoPonderado AlgoritmoTarjan::encontrarArborescenciaMinima<HeapRadix>(GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver*);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapSkew>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapLeftist>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapPairing>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapRadix>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapSkew>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapLeftist>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapPairing>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
+template const vector<int>& AlgoritmoTarjan::encontrarArestasArborescencia<HeapRadix>(const GrafoDirecionadoPonderado&, int, EspacoTrabalhoArborescencia&, EstatisticasSolver&);
@@ -0,0 +1,47 @@
+#include "ArquivoMapeado.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ArquivoMapeado::ArquivoMapeado(const std::string& caminho) {
+#ifdef _WIN32
+    std::ifstream f(caminho, std::ios::binary);
+    if (!f) throw std::runtime_error("Nao foi possivel abrir: " + caminho);
+    buffer.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    ptr = buffer.data();
+    n = buffer.size();
+#else
+    int fd = open(caminho.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Nao foi possivel abrir: " + caminho);
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Nao foi possivel ler: " + caminho);
+    }
+    n = (size_t)st.st_size;
+    if (n > 0) {
+        void* p = mmap(nullptr, n, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Falha no mmap: " + caminho);
+        }
+        madvise(p, n, MADV_SEQUENTIAL);
+        ptr = (const char*)p;
+    }
+    close(fd); // O mapeamento continua válido
+#endif
+}
+
+ArquivoMapeado::~ArquivoMapeado() {
+#ifndef _WIN32
+    if (ptr) munmap((void*)ptr, n);
+#endif
+}
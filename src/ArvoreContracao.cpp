@@ -0,0 +1,102 @@
+#include "ArvoreContracao.h"
+#include "Rastreamento.h"
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+template <class Heap>
+void ArvoreContracao::construir(const GrafoDirecionadoPonderado& grafo) {
+    n = grafo.numVertices();
+    const VisaoArcos reais = grafo.getArcos();
+    m = reais.size();
+
+    // Grafo aumentado: arestas reais + (s -> v) e (v -> s) para todo v
+    double grande = 1.0;
+    for (const auto& a : reais) grande += fabs(a.peso);
+    grande *= 2;
+
+    int s = n;
+    EscopoRastro rastroHeaps("contracao:heaps");
+    arestas.clear();
+    arestas.reserve(m + 2 * (size_t)n);
+    for (const auto& a : reais) arestas.push_back(a);
+    for (int v = 0; v < n; ++v) {
+        arestas.emplace_back(s, v, grande);
+        arestas.emplace_back(v, s, grande);
+    }
+
+    int total = n + 1;
+    espaco.preparar(total, arestas.size());
+    Heap heaps(espaco);
+    heaps.construir(arestas, total, -1);
+    rastroHeaps.encerrar();
+
+    DSUSupernos dsu(espaco.dsuPai);
+    vector<int>& noCaminho = espaco.marca;
+    vector<int>& entrada = espaco.arestaEntradaEscolhida;
+    vector<double>& pesoEntrada = espaco.pesoEntradaEscolhida;
+    vector<int>& pai = espaco.paiNaHierarquia;
+
+    // Um único caminho crescente a partir de 's': como o grafo é fortemente
+    // conexo, todo componente tem aresta de entrada até restar o topo
+    EscopoRastro rastroContracao("contracao:contracao");
+    numNos = total;
+    int curr = s;
+    noCaminho[curr] = 1;
+    while (true) {
+        double peso = 0;
+        NoHeap* minimo = heaps.minimo(curr, peso);
+        while (minimo && dsu.find(minimo->u) == curr) {
+            heaps.removerMinimo(curr);
+            minimo = heaps.minimo(curr, peso);
+        }
+        if (!minimo) break; // 'curr' é o topo da árvore
+
+        entrada[curr] = minimo->idOriginal;
+        pesoEntrada[curr] = peso;
+        int origem = dsu.find(minimo->u);
+
+        if (noCaminho[origem] == 1) {
+            // Ciclo: contrai os componentes do caminho de 'origem' até 'curr'
+            int novoSuperNo = numNos++;
+            int iter = curr;
+            do {
+                pai[iter] = novoSuperNo;
+                heaps.somar(iter, -pesoEntrada[iter]);
+                heaps.fundir(novoSuperNo, iter);
+                dsu.unite(iter, novoSuperNo);
+                iter = dsu.find(arestas[entrada[iter]].origem);
+            } while (iter != novoSuperNo);
+
+            noCaminho[novoSuperNo] = 1;
+            curr = novoSuperNo;
+        } else {
+            noCaminho[origem] = 1;
+            curr = origem;
+        }
+    }
+}
+
+const vector<int>& ArvoreContracao::extrair(int raiz) {
+    if (raiz < 0 || raiz >= n) {
+        throw runtime_error("Raiz fora do intervalo de vertices.");
+    }
+
+    EscopoRastro rastro("contracao:expansao");
+    espaco.expandirHierarquia(arestas, numNos, n, raiz);
+
+    // Arestas artificiais (saindo de 's') marcam as raízes das partes inalcançáveis
+    espaco.arestasEscolhidas.clear();
+    for (int v = 0; v < n; ++v) {
+        int e = espaco.entradaVertice[v];
+        if (e != -1 && (size_t)e < m) espaco.arestasEscolhidas.push_back(e);
+    }
+    return espaco.arestasEscolhidas;
+}
+
+// Instâncias das políticas disponíveis na CLI
+template void ArvoreContracao::construir<HeapSkew>(const GrafoDirecionadoPonderado&);
+template void ArvoreContracao::construir<HeapLeftist>(const GrafoDirecionadoPonderado&);
+template void ArvoreContracao::construir<HeapPairing>(const GrafoDirecionadoPonderado&);
+template void ArvoreContracao::construir<HeapRadix>(const GrafoDirecionadoPonderado&);
@@ -0,0 +1,82 @@
+#include "BenchmarkHeaps.h"
+#include "AlgoritmoTarjan.h"
+#include "AlgoritmoGabow.h"
+#include <chrono>
+#include <algorithm>
+
+using namespace std;
+
+typedef chrono::steady_clock Relogio;
+
+static double milissegundos(Relogio::time_point inicio) {
+    return chrono::duration<double, milli>(Relogio::now() - inicio).count();
+}
+
+template <class Heap>
+static ResultadoBenchHeap medir(PoliticaHeap politica, const GrafoDirecionadoPonderado& grafo, int repeticoes) {
+    const VisaoArcos arestas = grafo.getArcos();
+    int n = grafo.numVertices();
+    const double infinito = 1e300;
+
+    ResultadoBenchHeap r;
+    r.politica = politica;
+    r.construcao = r.remocoes = r.fusoes = r.tarjan = r.gabow = infinito;
+
+    EspacoTrabalhoArborescencia espaco;
+    for (int rep = 0; rep < repeticoes; ++rep) {
+        // Construção + remoção de todos os mínimos
+        espaco.preparar(n, arestas.size());
+        Heap heap(espaco);
+        auto inicio = Relogio::now();
+        heap.construir(arestas, n, -1);
+        r.construcao = min(r.construcao, milissegundos(inicio));
+
+        inicio = Relogio::now();
+        double peso;
+        for (int v = 0; v < n; ++v) {
+            while (heap.minimo(v, peso)) heap.removerMinimo(v);
+        }
+        r.remocoes = min(r.remocoes, milissegundos(inicio));
+
+        // Torneio de fusões: antes de cada fusão os dois heaps são deslocados
+        // pelo próprio mínimo, como na contração de um ciclo
+        espaco.preparar(n, arestas.size());
+        heap.construir(arestas, n, -1);
+        inicio = Relogio::now();
+        for (int passo = 1; passo < n; passo *= 2) {
+            for (int a = 0; a + passo < n; a += 2 * passo) {
+                int b = a + passo;
+                if (heap.minimo(a, peso)) heap.somar(a, -peso);
+                if (heap.minimo(b, peso)) heap.somar(b, -peso);
+                heap.fundir(a, b);
+            }
+        }
+        r.fusoes = min(r.fusoes, milissegundos(inicio));
+
+        // Algoritmos completos (o espaço já está aquecido)
+        AlgoritmoTarjan tarjan;
+        inicio = Relogio::now();
+        const vector<int>& t = tarjan.encontrarArestasArborescencia<Heap>(grafo, 0, espaco);
+        r.tarjan = min(r.tarjan, milissegundos(inicio));
+        r.pesoTarjan = 0;
+        for (int id : t) r.pesoTarjan += arestas[id].peso;
+
+        AlgoritmoGabow gabow;
+        inicio = Relogio::now();
+        const vector<int>& g = gabow.encontrarArestasArborescencia<Heap>(grafo, 0, espaco);
+        r.gabow = min(r.gabow, milissegundos(inicio));
+        r.pesoGabow = 0;
+        for (int id : g) r.pesoGabow += arestas[id].peso;
+    }
+    return r;
+}
+
+vector<ResultadoBenchHeap> BenchmarkHeaps::executar(const GrafoDirecionadoPonderado& grafo, int repeticoes) {
+    repeticoes = max(1, repeticoes);
+    vector<ResultadoBenchHeap> resultados;
+    resultados.push_back(medir<HeapSkew>(PoliticaHeap::SKEW, grafo, repeticoes));
+    resultados.push_back(medir<HeapLeftist>(PoliticaHeap::LEFTIST, grafo, repeticoes));
+    resultados.push_back(medir<HeapPairing>(PoliticaHeap::PAIRING, grafo, repeticoes));
+    resultados.push_back(medir<HeapRadix>(PoliticaHeap::RADIX, grafo, repeticoes));
+    return resultados;
+}
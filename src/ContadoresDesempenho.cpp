@@ -0,0 +1,185 @@
+#include "ContadoresDesempenho.h"
+#include "MedidorMemoria.h"
+#include <ostream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int abrirEvento(uint32_t tipo, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = tipo;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Com multiplexação o valor é extrapolado pelo tempo em que o evento rodou
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+static uint64_t lerEvento(int fd) {
+    uint64_t v[3] = {0, 0, 0}; // valor, tempo habilitado, tempo rodando
+    if (read(fd, v, sizeof(v)) != (ssize_t)sizeof(v) || v[2] == 0) return 0;
+    return v[2] < v[1] ? (uint64_t)((double)v[0] * v[1] / v[2]) : v[0];
+}
+#endif
+
+ContadoresDesempenho::ContadoresDesempenho(bool hardware, bool memoria) : hardware(hardware), memoria(memoria) {
+    for (int e = 0; e < NUM_EVENTOS; ++e) fd[e] = -1;
+#ifdef __linux__
+    if (!hardware) return;
+    fd[CICLOS] = abrirEvento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fd[INSTRUCOES] = abrirEvento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fd[FALHAS_CACHE] = abrirEvento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fd[ERROS_DESVIO] = abrirEvento(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    fd[FALTAS_PAGINA] = abrirEvento(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+#endif
+}
+
+ContadoresDesempenho::~ContadoresDesempenho() {
+#ifdef __linux__
+    for (int e = 0; e < NUM_EVENTOS; ++e) {
+        if (fd[e] >= 0) close(fd[e]);
+    }
+#endif
+}
+
+void ContadoresDesempenho::iniciarFase(const std::string& nome) {
+    if (!hardware && !memoria) return;
+    medicoes.emplace_back();
+    medicoes.back().nome = nome;
+    if (memoria) {
+        // Amostragem antes de ligar os contadores, para não entrar na medição
+        MedidorMemoria::devolverMemoriaLivre();
+        rssInicioKB = MedidorMemoria::statusKB("VmRSS");
+        picoReiniciado = MedidorMemoria::reiniciarPico();
+        alocacoesInicio = MedidorMemoria::alocacoes();
+        bytesInicio = MedidorMemoria::bytesAlocados();
+    }
+#ifdef __linux__
+    for (int e = 0; e < NUM_EVENTOS; ++e) {
+        if (fd[e] < 0) continue;
+        ioctl(fd[e], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd[e], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    inicio = std::chrono::steady_clock::now();
+}
+
+void ContadoresDesempenho::encerrarFase() {
+    if ((!hardware && !memoria) || medicoes.empty()) return;
+    auto fim = std::chrono::steady_clock::now();
+    MedicaoFase& m = medicoes.back();
+#ifdef __linux__
+    for (int e = 0; e < NUM_EVENTOS; ++e) {
+        if (fd[e] < 0) continue;
+        ioctl(fd[e], PERF_EVENT_IOC_DISABLE, 0);
+        m.valores[e] = lerEvento(fd[e]);
+    }
+#endif
+    m.ms = std::chrono::duration<double, std::milli>(fim - inicio).count();
+    if (memoria) {
+        m.rssKB = MedidorMemoria::statusKB("VmRSS");
+        // Sem clear_refs o VmHWM é o pico do processo inteiro, não da fase
+        if (picoReiniciado) m.picoKB = MedidorMemoria::statusKB("VmHWM");
+        if (m.picoKB >= 0 && rssInicioKB >= 0) m.crescimentoKB = std::max(0L, m.picoKB - rssInicioKB);
+        if (MedidorMemoria::contandoAlocacoes()) {
+            m.alocacoes = MedidorMemoria::alocacoes() - alocacoesInicio;
+            m.bytesAlocados = MedidorMemoria::bytesAlocados() - bytesInicio;
+        }
+    }
+}
+
+void ContadoresDesempenho::imprimir(std::ostream& saida, size_t pixels, size_t arestas) const {
+    if (hardware) imprimirHardware(saida, arestas);
+    if (memoria) imprimirMemoria(saida, pixels, arestas);
+}
+
+void ContadoresDesempenho::imprimirHardware(std::ostream& saida, size_t arestas) const {
+    char linha[256];
+    char col[NUM_EVENTOS + 3][24];
+
+    saida << "Contadores por fase (perf_event_open, espaco de usuario):\n";
+    snprintf(linha, sizeof(linha), "%-18s %9s %14s %14s %6s %12s %12s %11s %10s %10s\n", "fase", "ms", "ciclos",
+             "instrucoes", "IPC", "falhas_cache", "erros_desvio", "faltas_pag", "cache/ar", "desvio/ar");
+    saida << linha;
+
+    for (const auto& m : medicoes) {
+        // Colunas: os cinco eventos, IPC e os dois valores por aresta
+        for (int e = 0; e < NUM_EVENTOS; ++e) {
+            if (disponivel((EventoDesempenho)e)) snprintf(col[e], sizeof(col[e]), "%llu", (unsigned long long)m.valores[e]);
+            else snprintf(col[e], sizeof(col[e]), "-");
+        }
+        if (disponivel(CICLOS) && disponivel(INSTRUCOES) && m.valores[CICLOS] > 0)
+            snprintf(col[NUM_EVENTOS], sizeof(col[0]), "%.2f", (double)m.valores[INSTRUCOES] / m.valores[CICLOS]);
+        else
+            snprintf(col[NUM_EVENTOS], sizeof(col[0]), "-");
+        if (disponivel(FALHAS_CACHE) && arestas > 0)
+            snprintf(col[NUM_EVENTOS + 1], sizeof(col[0]), "%.3f", (double)m.valores[FALHAS_CACHE] / arestas);
+        else
+            snprintf(col[NUM_EVENTOS + 1], sizeof(col[0]), "-");
+        if (disponivel(ERROS_DESVIO) && arestas > 0)
+            snprintf(col[NUM_EVENTOS + 2], sizeof(col[0]), "%.3f", (double)m.valores[ERROS_DESVIO] / arestas);
+        else
+            snprintf(col[NUM_EVENTOS + 2], sizeof(col[0]), "-");
+
+        snprintf(linha, sizeof(linha), "%-18s %9.2f %14s %14s %6s %12s %12s %11s %10s %10s\n", m.nome.c_str(), m.ms,
+                 col[CICLOS], col[INSTRUCOES], col[NUM_EVENTOS], col[FALHAS_CACHE], col[ERROS_DESVIO],
+                 col[FALTAS_PAGINA], col[NUM_EVENTOS + 1], col[NUM_EVENTOS + 2]);
+        saida << linha;
+    }
+
+    bool algumHardware = false;
+    for (int e = CICLOS; e <= ERROS_DESVIO; ++e) algumHardware = algumHardware || disponivel((EventoDesempenho)e);
+    if (!algumHardware) {
+        saida << "(contadores de hardware indisponiveis: sem PMU exposta ou kernel.perf_event_paranoid restritivo)\n";
+    }
+}
+
+// Valor inteiro ou "-" quando negativo (não medido)
+static void formatar(char* destino, size_t tamanho, long long valor) {
+    if (valor >= 0) snprintf(destino, tamanho, "%lld", valor);
+    else snprintf(destino, tamanho, "-");
+}
+
+void ContadoresDesempenho::imprimirMemoria(std::ostream& saida, size_t pixels, size_t arestas) const {
+    const bool contando = MedidorMemoria::contandoAlocacoes();
+    char linha[256];
+    char rss[24], pico[24], cresc[24], aloc[24], bytes[24], porPixel[24], porAresta[24];
+
+    saida << "Memoria por fase (/proc/self/status" << (contando ? ", alocador contador" : "") << "):\n";
+    snprintf(linha, sizeof(linha), "%-18s %9s %10s %10s %10s %12s %14s %10s %10s\n", "fase", "ms", "rss_kb",
+             "pico_kb", "cresc_kb", "alocacoes", "bytes_aloc", "B/pixel", "B/aresta");
+    saida << linha;
+
+    for (const auto& m : medicoes) {
+        formatar(rss, sizeof(rss), m.rssKB);
+        formatar(pico, sizeof(pico), m.picoKB);
+        formatar(cresc, sizeof(cresc), m.crescimentoKB);
+        formatar(aloc, sizeof(aloc), m.alocacoes);
+        formatar(bytes, sizeof(bytes), m.bytesAlocados);
+
+        // Por pixel e por aresta: bytes alocados quando contados, senão o crescimento do RSS
+        long long base = contando ? m.bytesAlocados : (m.crescimentoKB >= 0 ? m.crescimentoKB * 1024LL : -1);
+        if (base >= 0 && pixels > 0) snprintf(porPixel, sizeof(porPixel), "%.2f", (double)base / pixels);
+        else snprintf(porPixel, sizeof(porPixel), "-");
+        if (base >= 0 && arestas > 0) snprintf(porAresta, sizeof(porAresta), "%.2f", (double)base / arestas);
+        else snprintf(porAresta, sizeof(porAresta), "-");
+
+        snprintf(linha, sizeof(linha), "%-18s %9.2f %10s %10s %10s %12s %14s %10s %10s\n", m.nome.c_str(), m.ms,
+                 rss, pico, cresc, aloc, bytes, porPixel, porAresta);
+        saida << linha;
+    }
+
+    if (!contando) {
+        saida << "(B/pixel e B/aresta pelo crescimento do RSS; 'make instrumentado' conta as alocacoes)\n";
+    }
+}
@@ -0,0 +1,377 @@
+#include "EscritorSaida.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+// Definida pela implementacao do stb (SegmentadorImagem.cpp), mas nao
+// declarada no cabecalho. Devolve o stream zlib alocado com malloc.
+extern "C" unsigned char* stbi_zlib_compress(unsigned char* data, int data_len, int* out_len, int quality);
+
+// CRC-32 (polinomio do PNG), tabela gerada na primeira chamada
+static uint32_t crc32Png(const unsigned char* dados, size_t tamanho, uint32_t crc = 0) {
+    static const std::vector<uint32_t> tabela = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < tamanho; ++i)
+        crc = tabela[(crc ^ dados[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void escreverU32BigEndian(unsigned char* p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)(v);
+}
+
+static bool escreverChunk(FILE* f, const char* tipo, const unsigned char* dados, uint32_t tamanho) {
+    unsigned char cabecalho[8];
+    escreverU32BigEndian(cabecalho, tamanho);
+    std::memcpy(cabecalho + 4, tipo, 4);
+
+    uint32_t crc = crc32Png(cabecalho + 4, 4);
+    crc = crc32Png(dados, tamanho, crc);
+
+    unsigned char rodape[4];
+    escreverU32BigEndian(rodape, crc);
+
+    return fwrite(cabecalho, 1, 8, f) == 8
+        && (tamanho == 0 || fwrite(dados, 1, tamanho, f) == tamanho)
+        && fwrite(rodape, 1, 4, f) == 4;
+}
+
+static uint32_t adler32(const unsigned char* dados, size_t tamanho) {
+    uint32_t s1 = 1, s2 = 0;
+    while (tamanho > 0) {
+        size_t k = std::min<size_t>(tamanho, 5552); // maior bloco sem estouro de 32 bits
+        for (size_t i = 0; i < k; ++i) {
+            s1 += dados[i];
+            s2 += s1;
+        }
+        s1 %= 65521; s2 %= 65521;
+        dados += k; tamanho -= k;
+    }
+    return (s2 << 16) | s1;
+}
+
+static void anexarAdler32(std::vector<unsigned char>& zlib, const std::vector<unsigned char>& dados) {
+    unsigned char adler[4];
+    escreverU32BigEndian(adler, adler32(dados.data(), dados.size()));
+    zlib.insert(zlib.end(), adler, adler + 4);
+}
+
+static unsigned char paeth(int a, int b, int c) {
+    int p = a + b - c, pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) return (unsigned char)a;
+    return (unsigned char)(pb <= pc ? b : c);
+}
+
+// Aplica o filtro PNG 'tipo' (0..4) a uma linha RGB; 'anterior' nulo na primeira linha
+static void filtrarLinha(const unsigned char* linha, const unsigned char* anterior, size_t bytesLinha, int tipo, unsigned char* saida) {
+    for (size_t i = 0; i < bytesLinha; ++i) {
+        int a = i >= 3 ? linha[i - 3] : 0;
+        int b = anterior ? anterior[i] : 0;
+        int c = (anterior && i >= 3) ? anterior[i - 3] : 0;
+        switch (tipo) {
+            case 0: saida[i] = linha[i]; break;
+            case 1: saida[i] = (unsigned char)(linha[i] - a); break;
+            case 2: saida[i] = (unsigned char)(linha[i] - b); break;
+            case 3: saida[i] = (unsigned char)(linha[i] - ((a + b) >> 1)); break;
+            default: saida[i] = (unsigned char)(linha[i] - paeth(a, b, c)); break;
+        }
+    }
+}
+
+// Dados brutos do IDAT (byte de filtro + linha filtrada). Nivel 0 nao filtra,
+// 1-4 usam sempre "sub" e 5-9 escolhem por linha o filtro de menor soma dos
+// residuos em modulo, a mesma heuristica do stb.
+static void filtrarImagem(int largura, int altura, const unsigned char* rgb, int nivel, std::vector<unsigned char>& bruto) {
+    const size_t bytesLinha = (size_t)largura * 3;
+    bruto.resize((size_t)altura * (bytesLinha + 1));
+    std::vector<unsigned char> tentativa(nivel >= 5 ? bytesLinha : 0);
+
+    for (int y = 0; y < altura; ++y) {
+        const unsigned char* linha = rgb + y * bytesLinha;
+        const unsigned char* anterior = y > 0 ? linha - bytesLinha : nullptr;
+        unsigned char* destino = bruto.data() + y * (bytesLinha + 1);
+
+        int tipo = nivel == 0 ? 0 : 1;
+        if (nivel >= 5) {
+            long melhorSoma = -1;
+            for (int t = 0; t < 5; ++t) {
+                filtrarLinha(linha, anterior, bytesLinha, t, tentativa.data());
+                long soma = 0;
+                for (size_t i = 0; i < bytesLinha; ++i) soma += std::abs((int)(signed char)tentativa[i]);
+                if (melhorSoma < 0 || soma < melhorSoma) { melhorSoma = soma; tipo = t; }
+            }
+        }
+        destino[0] = (unsigned char)tipo;
+        filtrarLinha(linha, anterior, bytesLinha, tipo, destino + 1);
+    }
+}
+
+// Stream zlib com blocos deflate "stored": sem busca de padroes
+static void zlibArmazenado(const std::vector<unsigned char>& dados, std::vector<unsigned char>& zlib) {
+    const size_t maxBloco = 65535;
+    zlib.reserve(2 + dados.size() + (dados.size() / maxBloco + 1) * 5 + 4);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+
+    size_t pos = 0;
+    do {
+        size_t len = std::min(maxBloco, dados.size() - pos);
+        bool final = (pos + len == dados.size());
+        zlib.push_back(final ? 1 : 0);
+        zlib.push_back((unsigned char)(len & 0xFF));
+        zlib.push_back((unsigned char)(len >> 8));
+        zlib.push_back((unsigned char)(~len & 0xFF));
+        zlib.push_back((unsigned char)((~len >> 8) & 0xFF));
+        zlib.insert(zlib.end(), dados.begin() + pos, dados.begin() + pos + len);
+        pos += len;
+    } while (pos < dados.size());
+
+    anexarAdler32(zlib, dados);
+}
+
+// Tabelas do deflate com codigos de Huffman fixos (RFC 1951, 3.2.5 e 3.2.6)
+static const uint16_t BASE_COMPRIMENTO[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t EXTRA_COMPRIMENTO[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t BASE_DISTANCIA[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t EXTRA_DISTANCIA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+struct TabelasDeflate {
+    uint16_t codigoLiteral[288];   // bits ja invertidos: o deflate grava os codigos a partir do MSB
+    uint8_t bitsLiteral[288];
+    uint8_t codigoDistancia[30];
+    uint8_t simboloComprimento[259];  // comprimento 3..258 -> indice em BASE_COMPRIMENTO
+    uint8_t simboloDistancia[512];    // d-1 < 256 -> [d-1]; senao [256 + ((d-1) >> 7)]
+};
+
+static uint32_t inverterBits(uint32_t codigo, int bits) {
+    uint32_t r = 0;
+    for (int i = 0; i < bits; ++i) { r = (r << 1) | (codigo & 1); codigo >>= 1; }
+    return r;
+}
+
+static const TabelasDeflate& tabelasDeflate() {
+    static const TabelasDeflate tabelas = [] {
+        TabelasDeflate t = {};
+        for (int s = 0; s < 288; ++s) {
+            if (s <= 143)      { t.codigoLiteral[s] = (uint16_t)inverterBits(0x30 + s, 8);          t.bitsLiteral[s] = 8; }
+            else if (s <= 255) { t.codigoLiteral[s] = (uint16_t)inverterBits(0x190 + s - 144, 9);   t.bitsLiteral[s] = 9; }
+            else if (s <= 279) { t.codigoLiteral[s] = (uint16_t)inverterBits(s - 256, 7);          t.bitsLiteral[s] = 7; }
+            else               { t.codigoLiteral[s] = (uint16_t)inverterBits(0xC0 + s - 280, 8);    t.bitsLiteral[s] = 8; }
+        }
+        for (int c = 0; c < 29; ++c) {
+            for (int len = BASE_COMPRIMENTO[c]; len < BASE_COMPRIMENTO[c] + (1 << EXTRA_COMPRIMENTO[c]) && len <= 258; ++len)
+                t.simboloComprimento[len] = (uint8_t)c;
+        }
+        t.simboloComprimento[258] = 28; // 258 tem codigo proprio, sem bits extras
+        for (int c = 0; c < 30; ++c) {
+            t.codigoDistancia[c] = (uint8_t)inverterBits(c, 5);
+            for (int d = BASE_DISTANCIA[c]; d < BASE_DISTANCIA[c] + (1 << EXTRA_DISTANCIA[c]); ++d) {
+                if (d - 1 < 256) t.simboloDistancia[d - 1] = (uint8_t)c;
+                else t.simboloDistancia[256 + ((d - 1) >> 7)] = (uint8_t)c;
+            }
+        }
+        return t;
+    }();
+    return tabelas;
+}
+
+// Escrita de bits LSB-first, descarregando 32 bits por vez
+struct EscritorBits {
+    std::vector<unsigned char>& saida;
+    uint64_t buffer = 0;
+    int bits = 0;
+
+    void escrever(uint32_t valor, int n) {
+        buffer |= (uint64_t)valor << bits;
+        bits += n;
+        if (bits >= 32) {
+            for (int k = 0; k < 4; ++k) { saida.push_back((unsigned char)buffer); buffer >>= 8; }
+            bits -= 32;
+        }
+    }
+
+    void finalizar() {
+        while (bits > 0) { saida.push_back((unsigned char)buffer); buffer >>= 8; bits -= 8; }
+        bits = 0;
+    }
+};
+
+// Deflate guloso em um unico bloco de Huffman fixo, para os niveis 1-4. Cada
+// posicao consulta uma tabela hash de trincas; o nivel define quantos
+// candidatos anteriores com o mesmo hash sao comparados (1, 2, 4 ou 8). Apos o
+// filtro "sub", as regioes de cor uniforme viram sequencias de zeros que a
+// distancia 1 comprime como RLE, entao um candidato ja resolve quase tudo.
+static void zlibRapido(const std::vector<unsigned char>& dados, int nivel, std::vector<unsigned char>& zlib) {
+    const TabelasDeflate& t = tabelasDeflate();
+    const unsigned char* d = dados.data();
+    const size_t n = dados.size();
+    const int BITS_HASH = 15;
+    const size_t JANELA = 32768, MASCARA = JANELA - 1;
+    const int candidatos = 1 << (nivel - 1);
+
+    std::vector<int32_t> cabeca((size_t)1 << BITS_HASH, -1);
+    std::vector<int32_t> anterior(nivel > 1 ? JANELA : 0);
+    auto hash3 = [d](size_t i) {
+        uint32_t v = (uint32_t)d[i] | ((uint32_t)d[i + 1] << 8) | ((uint32_t)d[i + 2] << 16);
+        return (v * 2654435761u) >> (32 - BITS_HASH);
+    };
+    auto inserir = [&](size_t i) {
+        uint32_t h = hash3(i);
+        int32_t antigo = cabeca[h];
+        if (nivel > 1) anterior[i & MASCARA] = antigo;
+        cabeca[h] = (int32_t)i;
+        return antigo;
+    };
+
+    zlib.reserve(n / 4 + 64);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    EscritorBits saida{zlib};
+    saida.escrever(1, 1); // BFINAL
+    saida.escrever(1, 2); // BTYPE = 01 (Huffman fixo)
+
+    size_t i = 0;
+    while (i + 3 <= n) {
+        int32_t candidato = inserir(i);
+        size_t limite = std::min<size_t>(258, n - i);
+        size_t melhor = 0, distancia = 0;
+
+        for (int k = 0; k < candidatos && candidato >= 0 && i - (size_t)candidato <= JANELA; ++k) {
+            const unsigned char* a = d + candidato;
+            const unsigned char* b = d + i;
+            if (a[melhor] == b[melhor]) {
+                size_t len = 0;
+                while (len < limite && a[len] == b[len]) ++len;
+                if (len > melhor) {
+                    melhor = len;
+                    distancia = i - candidato;
+                    if (len == limite) break;
+                }
+            }
+            if (nivel == 1) break;
+            int32_t proximo = anterior[candidato & MASCARA];
+            if (proximo >= candidato) break; // entrada sobrescrita por uma posicao mais nova
+            candidato = proximo;
+        }
+
+        if (melhor >= 3) {
+            int c = t.simboloComprimento[melhor];
+            saida.escrever(t.codigoLiteral[257 + c], t.bitsLiteral[257 + c]);
+            if (EXTRA_COMPRIMENTO[c]) saida.escrever((uint32_t)(melhor - BASE_COMPRIMENTO[c]), EXTRA_COMPRIMENTO[c]);
+            int cd = distancia - 1 < 256 ? t.simboloDistancia[distancia - 1] : t.simboloDistancia[256 + ((distancia - 1) >> 7)];
+            saida.escrever(t.codigoDistancia[cd], 5);
+            if (EXTRA_DISTANCIA[cd]) saida.escrever((uint32_t)(distancia - BASE_DISTANCIA[cd]), EXTRA_DISTANCIA[cd]);
+
+            // No nivel 1 as posicoes dentro da repeticao nao entram no hash
+            if (nivel > 1) {
+                for (size_t p = i + 1; p < i + melhor && p + 3 <= n; ++p) inserir(p);
+            }
+            i += melhor;
+        } else {
+            saida.escrever(t.codigoLiteral[d[i]], t.bitsLiteral[d[i]]);
+            ++i;
+        }
+    }
+    for (; i < n; ++i) saida.escrever(t.codigoLiteral[d[i]], t.bitsLiteral[d[i]]);
+    saida.escrever(t.codigoLiteral[256], t.bitsLiteral[256]); // fim de bloco
+    saida.finalizar();
+
+    anexarAdler32(zlib, dados);
+}
+
+static bool gravarPNG(const std::string& caminho, int largura, int altura, const unsigned char* idat, size_t tamanhoIdat) {
+    FILE* f = fopen(caminho.c_str(), "wb");
+    if (!f) return false;
+
+    const unsigned char assinatura[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    unsigned char ihdr[13];
+    escreverU32BigEndian(ihdr, (uint32_t)largura);
+    escreverU32BigEndian(ihdr + 4, (uint32_t)altura);
+    ihdr[8] = 8;  // bits por canal
+    ihdr[9] = 2;  // RGB
+    ihdr[10] = ihdr[11] = ihdr[12] = 0;
+
+    bool ok = fwrite(assinatura, 1, 8, f) == 8
+        && escreverChunk(f, "IHDR", ihdr, 13)
+        && escreverChunk(f, "IDAT", idat, (uint32_t)tamanhoIdat)
+        && escreverChunk(f, "IEND", nullptr, 0);
+    return fclose(f) == 0 && ok;
+}
+
+bool EscritorSaida::escreverPNG(const std::string& caminho, int largura, int altura, const unsigned char* rgb, int nivelCompressao) {
+    int nivel = std::max(0, std::min(9, nivelCompressao));
+    std::vector<unsigned char> bruto;
+    filtrarImagem(largura, altura, rgb, nivel, bruto);
+
+    if (nivel >= 5) {
+        // Deflate do stb com o nivel passado como argumento: nao usa
+        // stbi_write_png_compression_level nem stbi_write_force_png_filter,
+        // globais que outras threads (lote, servidor) estariam lendo.
+        int tamanho = 0;
+        unsigned char* zlib = stbi_zlib_compress(bruto.data(), (int)bruto.size(), &tamanho, nivel);
+        if (!zlib) return false;
+        bool ok = gravarPNG(caminho, largura, altura, zlib, (size_t)tamanho);
+        free(zlib);
+        return ok;
+    }
+
+    std::vector<unsigned char> zlib;
+    if (nivel == 0) zlibArmazenado(bruto, zlib);
+    else zlibRapido(bruto, nivel, zlib);
+    return gravarPNG(caminho, largura, altura, zlib.data(), zlib.size());
+}
+
+bool EscritorSaida::escreverPPM(const std::string& caminho, int largura, int altura, const unsigned char* rgb) {
+    FILE* f = fopen(caminho.c_str(), "wb");
+    if (!f) return false;
+
+    size_t tamanho = (size_t)largura * altura * 3;
+    bool ok = fprintf(f, "P6\n%d %d\n255\n", largura, altura) > 0
+        && fwrite(rgb, 1, tamanho, f) == tamanho;
+    return fclose(f) == 0 && ok;
+}
+
+bool EscritorSaida::escreverRotulos(const std::string& caminho, int largura, int altura, const std::vector<uint32_t>& rotulos, uint32_t numRegioes) {
+    FILE* f = fopen(caminho.c_str(), "wb");
+    if (!f) return false;
+
+    CabecalhoRotulos cab = {};
+    std::memcpy(cab.magica, "SEGR", 4);
+    cab.versao = 1;
+    cab.largura = (uint32_t)largura;
+    cab.altura = (uint32_t)altura;
+    cab.numRegioes = numRegioes;
+
+    bool ok = fwrite(&cab, sizeof(cab), 1, f) == 1
+        && fwrite(rotulos.data(), sizeof(uint32_t), rotulos.size(), f) == rotulos.size();
+    return fclose(f) == 0 && ok;
+}
+
+const char* EscritorSaida::extensao(FormatoSaida formato) {
+    switch (formato) {
+        case FormatoSaida::PPM: return "ppm";
+        case FormatoSaida::ROTULOS: return "lbl";
+        default: return "png";
+    }
+}
+
+bool EscritorSaida::formatoPorNome(const std::string& nome, FormatoSaida& formato) {
+    if (nome == "png") formato = FormatoSaida::PNG;
+    else if (nome == "ppm") formato = FormatoSaida::PPM;
+    else if (nome == "rotulos" || nome == "lbl") formato = FormatoSaida::ROTULOS;
+    else return false;
+    return true;
+}
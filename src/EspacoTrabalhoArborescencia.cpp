@@ -0,0 +1,137 @@
+#include "EspacoTrabalhoArborescencia.h"
+#include <algorithm>
+
+// Desce o nó 'i' no heap armazenado em 'a[0, tam)'
+static void descer(NoHeapArborescencia* a, int tam, int i) {
+    NoHeapArborescencia x = a[i];
+    while (true) {
+        int filho = 2 * i + 1;
+        if (filho >= tam) break;
+        if (filho + 1 < tam && a[filho + 1].val < a[filho].val) filho++;
+        if (!(a[filho].val < x.val)) break;
+        a[i] = a[filho];
+        i = filho;
+    }
+    a[i] = x;
+}
+
+void EspacoTrabalhoArborescencia::agruparPorDestino(const VisaoArcos& arestas, int n, int raiz) {
+    // 1. Conta as arestas de entrada de cada destino
+    inicioDestino.assign(n + 1, 0);
+    for (const auto& aresta : arestas) {
+        if (aresta.destino == raiz || aresta.origem == aresta.destino) continue;
+        inicioDestino[aresta.destino + 1]++;
+    }
+    for (int v = 0; v < n; ++v) inicioDestino[v + 1] += inicioDestino[v];
+    nosUsados = inicioDestino[n];
+
+    // 2. Distribui os nós agrupados por destino (inicioDestino[v] avança até o fim do grupo)
+    for (size_t i = 0; i < arestas.size(); ++i) {
+        const auto& aresta = arestas[i];
+        if (aresta.destino == raiz || aresta.origem == aresta.destino) continue;
+        int pos = inicioDestino[aresta.destino]++;
+        nos[pos] = {aresta.peso, 0, aresta.origem, aresta.destino, (int)i, 1, nullptr, nullptr};
+    }
+}
+
+void EspacoTrabalhoArborescencia::construirHeaps(const VisaoArcos& arestas, int n, int raiz) {
+    agruparPorDestino(arestas, n, raiz);
+
+    // 3. Heapify de cada grupo e ligação dos filhos
+    int inicio = 0;
+    for (int v = 0; v < n; ++v) {
+        int fim = inicioDestino[v];
+        int tam = fim - inicio;
+        if (tam > 0) {
+            NoHeapArborescencia* a = &nos[inicio];
+            for (int i = tam / 2 - 1; i >= 0; --i) descer(a, tam, i);
+            for (int i = 0; i < tam; ++i) {
+                a[i].left = (2 * i + 1 < tam) ? &a[2 * i + 1] : nullptr;
+                a[i].right = (2 * i + 2 < tam) ? &a[2 * i + 2] : nullptr;
+            }
+            heaps[v] = a;
+        }
+        inicio = fim;
+    }
+}
+
+// Calcula o rank de uma subárvore e garante rank(left) >= rank(right).
+// A árvore vem do heapify, então a recursão tem profundidade O(log n).
+static int ajustarLeftist(NoHeapArborescencia* t) {
+    if (!t) return 0;
+    int rl = ajustarLeftist(t->left);
+    int rr = ajustarLeftist(t->right);
+    if (rl < rr) {
+        std::swap(t->left, t->right);
+        std::swap(rl, rr);
+    }
+    t->rank = rr + 1;
+    return t->rank;
+}
+
+void EspacoTrabalhoArborescencia::construirHeapsLeftist(const VisaoArcos& arestas, int n, int raiz) {
+    construirHeaps(arestas, n, raiz);
+    for (int v = 0; v < n; ++v) ajustarLeftist(heaps[v]);
+}
+
+void EspacoTrabalhoArborescencia::construirHeapsPairing(const VisaoArcos& arestas, int n, int raiz) {
+    agruparPorDestino(arestas, n, raiz);
+
+    // Raiz = menor aresta do grupo; as demais viram filhos encadeados por 'right'
+    int inicio = 0;
+    for (int v = 0; v < n; ++v) {
+        int fim = inicioDestino[v];
+        if (fim > inicio) {
+            NoHeapArborescencia* a = &nos[inicio];
+            int tam = fim - inicio;
+            int menor = 0;
+            for (int i = 1; i < tam; ++i)
+                if (a[i].val < a[menor].val) menor = i;
+            std::swap(a[0], a[menor]);
+
+            a[0].left = (tam > 1) ? &a[1] : nullptr;
+            for (int i = 1; i < tam; ++i) a[i].right = (i + 1 < tam) ? &a[i + 1] : nullptr;
+            heaps[v] = a;
+        }
+        inicio = fim;
+    }
+}
+
+void EspacoTrabalhoArborescencia::construirHeapsRadix(const VisaoArcos& arestas, int n, int raiz) {
+    agruparPorDestino(arestas, n, raiz);
+
+    estadosRadix.assign(2 * (size_t)n, EstadoRadix{nullptr, nullptr, 0, 0, 0.0, -1, 0});
+    int inicio = 0;
+    for (int v = 0; v < n; ++v) {
+        int fim = inicioDestino[v];
+        for (int i = inicio; i < fim; ++i) nos[i].right = (i + 1 < fim) ? &nos[i + 1] : nullptr;
+        if (fim > inicio) {
+            estadosRadix[v].lista = &nos[inicio];
+            estadosRadix[v].tamanho = fim - inicio;
+        }
+        inicio = fim;
+    }
+}
+
+void EspacoTrabalhoArborescencia::expandirHierarquia(const VisaoArcos& arestas, int numNos, int numVertices, int raiz) {
+    numNosHierarquia = numNos;
+    removido.assign(numNos, 0);
+    entradaVertice.assign(numVertices, -1);
+
+    // O caminho da raiz até o topo não recebe aresta
+    for (int x = raiz; x != -1; x = paiNaHierarquia[x]) removido[x] = 1;
+
+    // A aresta escolhida por 'u' entra em um vértice 'v' e substitui as escolhas
+    // de todos os nós entre 'v' e 'u', que são removidos. Cada nó é removido uma
+    // única vez, então a passada inteira é linear.
+    for (int u = numNos - 1; u >= 0; --u) {
+        if (removido[u]) continue;
+        removido[u] = 1;
+        int e = arestaEntradaEscolhida[u];
+        if (e == -1) continue; // Topo inalcançável: os filhos mantêm as próprias escolhas
+
+        int v = arestas[e].destino;
+        for (int x = v; x != u; x = paiNaHierarquia[x]) removido[x] = 1;
+        if (v < numVertices) entradaVertice[v] = e;
+    }
+}
@@ -0,0 +1,114 @@
+#include "GeradorGrafos.h"
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+GrafoDirecionadoPonderado GeradorGrafos::grade(int largura, int altura, unsigned semente) {
+    mt19937 rng(semente);
+    uniform_real_distribution<double> peso(0.0, 1.0);
+
+    GrafoDirecionadoPonderado grafo(largura * altura);
+    for (int y = 0; y < altura; ++y) {
+        for (int x = 0; x < largura; ++x) {
+            int v = y * largura + x;
+            if (x + 1 < largura) {
+                double w = peso(rng);
+                grafo.adicionarAresta(v, v + 1, w);
+                grafo.adicionarAresta(v + 1, v, w);
+            }
+            if (y + 1 < altura) {
+                double w = peso(rng);
+                grafo.adicionarAresta(v, v + largura, w);
+                grafo.adicionarAresta(v + largura, v, w);
+            }
+        }
+    }
+    return grafo;
+}
+
+GrafoDirecionadoPonderado GeradorGrafos::aleatorio(int n, int grau, unsigned semente) {
+    mt19937 rng(semente);
+    uniform_int_distribution<int> vertice(0, max(0, n - 1));
+    uniform_real_distribution<double> peso(0.0, 1.0);
+
+    GrafoDirecionadoPonderado grafo(n);
+    for (int v = 1; v < n; ++v) {
+        grafo.adicionarAresta(v - 1, v, peso(rng));
+        for (int k = 1; k < grau; ++k) {
+            int u = vertice(rng);
+            if (u != v) grafo.adicionarAresta(u, v, peso(rng));
+        }
+    }
+    return grafo;
+}
+
+GrafoDirecionadoPonderado GeradorGrafos::denso(int n, double probabilidade, unsigned semente) {
+    mt19937 rng(semente);
+    uniform_real_distribution<double> peso(0.0, 1.0);
+    bernoulli_distribution sorteio(probabilidade);
+
+    GrafoDirecionadoPonderado grafo(n);
+    for (int v = 1; v < n; ++v) {
+        grafo.adicionarAresta(v - 1, v, 1.0 + peso(rng)); // Alcançabilidade, raramente ótima
+    }
+    for (int u = 0; u < n; ++u) {
+        for (int v = 1; v < n; ++v) {
+            if (u != v && sorteio(rng)) grafo.adicionarAresta(u, v, peso(rng));
+        }
+    }
+    return grafo;
+}
+
+GrafoDirecionadoPonderado GeradorGrafos::completo(int n, unsigned semente) {
+    mt19937 rng(semente);
+    uniform_real_distribution<double> peso(0.0, 1.0);
+
+    GrafoDirecionadoPonderado grafo(n);
+    for (int u = 0; u < n; ++u) {
+        for (int v = 0; v < n; ++v) {
+            if (u != v) grafo.adicionarAresta(u, v, peso(rng));
+        }
+    }
+    return grafo;
+}
+
+GrafoDirecionadoPonderado GeradorGrafos::ciclosAninhados(int n, unsigned semente) {
+    mt19937 rng(semente);
+    uniform_real_distribution<double> ruido(0.0, 0.25);
+
+    // Entrada mais barata de k vem de k-1 (peso ~1); a de {1..k-1}, já reduzida,
+    // vem de k (peso ~2 menos y(k-1) ~ 1). As arestas da raiz (3n) só entram
+    // na solução pelo vértice 1, depois de todas as contrações.
+    GrafoDirecionadoPonderado grafo(n);
+    for (int k = 1; k < n; ++k) {
+        grafo.adicionarAresta(0, k, 3.0 * n);
+        if (k >= 2) {
+            grafo.adicionarAresta(k - 1, k, 1.0 + ruido(rng));
+            grafo.adicionarAresta(k, k - 1, 2.0 + ruido(rng));
+        }
+    }
+    return grafo;
+}
+
+bool GeradorGrafos::porNome(const string& nome, int n, unsigned semente,
+                            GrafoDirecionadoPonderado& grafo, bool& simetrico) {
+    simetrico = false;
+    if (nome == "grade") {
+        int lado = max(2, (int)lround(sqrt((double)n)));
+        grafo = grade(lado, lado, semente);
+        simetrico = true;
+    } else if (nome == "esparso") {
+        grafo = aleatorio(n, 4, semente);
+    } else if (nome == "denso") {
+        grafo = denso(n, 0.1, semente);
+    } else if (nome == "completo") {
+        grafo = completo(n, semente);
+    } else if (nome == "aninhado") {
+        grafo = ciclosAninhados(n, semente);
+    } else {
+        return false;
+    }
+    return true;
+}
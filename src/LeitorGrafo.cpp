@@ -0,0 +1,189 @@
+#include "LeitorGrafo.h"
+#include "PoolThreads.h"
+#include "ArquivoMapeado.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Resultado da leitura de um bloco de linhas
+struct BlocoLido {
+    vector<Aresta> arestas;
+    int maiorVertice = -1;
+    long long cabecalhoV = -1;      // Linha "p" (DIMACS), se estiver neste bloco
+    long long cabecalhoE = -1;
+    string erro;
+    const char* posicaoErro = nullptr;
+};
+
+static inline bool espaco(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline const char* pularEspacos(const char* p, const char* fim) {
+    while (p < fim && espaco(*p)) ++p;
+    return p;
+}
+
+template <class T>
+static inline bool lerNumero(const char*& p, const char* fim, T& valor) {
+    p = pularEspacos(p, fim);
+    if (p < fim && *p == '+') ++p; // from_chars não aceita o sinal positivo
+    auto r = from_chars(p, fim, valor);
+    if (r.ec != errc()) return false;
+    p = r.ptr;
+    return p == fim || espaco(*p) || *p == '\n';
+}
+
+// Interpreta as linhas de [inicio, fim); 'inicio' está no começo de uma linha
+static void lerBloco(const char* inicio, const char* fim, FormatoGrafo formato, BlocoLido& bloco) {
+    const bool dimacs = formato == FormatoGrafo::DIMACS;
+    const int deslocamento = dimacs ? 1 : 0;
+
+    const char* p = inicio;
+    while (p < fim) {
+        const char* linha = p;
+        const char* fimLinha = (const char*)memchr(p, '\n', fim - p);
+        if (!fimLinha) fimLinha = fim;
+        p = fimLinha + 1;
+
+        const char* q = pularEspacos(linha, fimLinha);
+        if (q == fimLinha || *q == '#' || *q == '%') continue;
+
+        if (dimacs) {
+            char tipo = *q++;
+            if (tipo == 'c') continue;
+            if (tipo == 'p') {
+                // "p <problema> <V> <E>": o nome do problema é ignorado
+                q = pularEspacos(q, fimLinha);
+                while (q < fimLinha && !espaco(*q)) ++q;
+                if (!lerNumero(q, fimLinha, bloco.cabecalhoV) || !lerNumero(q, fimLinha, bloco.cabecalhoE)
+                    || bloco.cabecalhoV < 0 || bloco.cabecalhoV > 2147483647LL || bloco.cabecalhoE < 0) {
+                    bloco.erro = "cabecalho DIMACS invalido";
+                    bloco.posicaoErro = linha;
+                    return;
+                }
+                continue;
+            }
+            if (tipo != 'a') {
+                bloco.erro = "linha DIMACS nao reconhecida";
+                bloco.posicaoErro = linha;
+                return;
+            }
+        }
+
+        int u, v;
+        double peso = 1.0; // Listas sem peso valem 1
+        bool ok = lerNumero(q, fimLinha, u) && lerNumero(q, fimLinha, v);
+        if (ok) {
+            q = pularEspacos(q, fimLinha);
+            if (q < fimLinha) ok = lerNumero(q, fimLinha, peso);
+            else ok = !dimacs;
+        }
+        if (ok && pularEspacos(q, fimLinha) != fimLinha) ok = false;
+        u -= deslocamento;
+        v -= deslocamento;
+        if (!ok || u < 0 || v < 0) {
+            bloco.erro = ok ? "indice de vertice invalido" : "aresta mal formada";
+            bloco.posicaoErro = linha;
+            return;
+        }
+
+        bloco.arestas.emplace_back(u, v, peso);
+        bloco.maiorVertice = max(bloco.maiorVertice, max(u, v));
+    }
+}
+
+FormatoGrafo LeitorGrafo::detectarFormato(const char* inicio, const char* fim) {
+    const char* p = inicio;
+    while (p < fim) {
+        const char* fimLinha = (const char*)memchr(p, '\n', fim - p);
+        if (!fimLinha) fimLinha = fim;
+        const char* q = pularEspacos(p, fimLinha);
+        p = fimLinha + 1;
+        if (q == fimLinha || *q == '#' || *q == '%' || *q == 'c') continue;
+        return *q == 'p' ? FormatoGrafo::DIMACS : FormatoGrafo::LISTA;
+    }
+    return FormatoGrafo::LISTA;
+}
+
+GrafoDirecionadoPonderado LeitorGrafo::carregar(const string& caminho, int threads) {
+    ArquivoMapeado arquivo(caminho);
+    const char* inicio = arquivo.dados();
+    const char* fim = inicio + arquivo.tamanho();
+    FormatoGrafo formato = detectarFormato(inicio, fim);
+
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+
+    // Blocos de pelo menos 1 MB, alguns por thread para equilibrar a carga,
+    // com as fronteiras avançadas até a próxima quebra de linha
+    const size_t minimoBloco = 1 << 20;
+    size_t numBlocos = min((size_t)threads * 4, max((size_t)1, arquivo.tamanho() / minimoBloco));
+    vector<const char*> fronteiras(1, inicio);
+    for (size_t b = 1; b < numBlocos; ++b) {
+        const char* p = max(fronteiras.back(), inicio + arquivo.tamanho() * b / numBlocos);
+        const char* nl = p < fim ? (const char*)memchr(p, '\n', fim - p) : nullptr;
+        p = nl ? nl + 1 : fim;
+        if (p > fronteiras.back() && p < fim) fronteiras.push_back(p);
+    }
+    fronteiras.push_back(fim);
+    numBlocos = fronteiras.size() - 1;
+
+    vector<BlocoLido> blocos(numBlocos);
+    if (numBlocos == 1 || threads == 1) {
+        for (size_t b = 0; b < numBlocos; ++b) lerBloco(fronteiras[b], fronteiras[b + 1], formato, blocos[b]);
+    } else {
+        PoolThreads pool(min((int)numBlocos, threads));
+        for (size_t b = 0; b < numBlocos; ++b) {
+            pool.enfileirar([&, b](int) { lerBloco(fronteiras[b], fronteiras[b + 1], formato, blocos[b]); });
+        }
+        pool.aguardar();
+    }
+
+    // Junta os blocos na ordem do arquivo, validando erros e o cabeçalho
+    size_t total = 0;
+    int maiorVertice = -1;
+    long long cabecalhoV = -1, cabecalhoE = -1;
+    for (const auto& bloco : blocos) {
+        if (!bloco.erro.empty()) {
+            long long linha = 1 + count(inicio, bloco.posicaoErro, '\n');
+            throw runtime_error(caminho + ":" + to_string(linha) + ": " + bloco.erro);
+        }
+        if (bloco.cabecalhoV >= 0) {
+            if (cabecalhoV >= 0) throw runtime_error(caminho + ": mais de um cabecalho DIMACS");
+            cabecalhoV = bloco.cabecalhoV;
+            cabecalhoE = bloco.cabecalhoE;
+        }
+        total += bloco.arestas.size();
+        maiorVertice = max(maiorVertice, bloco.maiorVertice);
+    }
+
+    int vertices = maiorVertice + 1;
+    if (formato == FormatoGrafo::DIMACS) {
+        if (cabecalhoV < 0) throw runtime_error(caminho + ": arestas antes do cabecalho DIMACS");
+        if (maiorVertice >= cabecalhoV) {
+            throw runtime_error(caminho + ": vertice " + to_string(maiorVertice + 1) + " acima do declarado no cabecalho");
+        }
+        if ((long long)total != cabecalhoE) {
+            throw runtime_error(caminho + ": cabecalho declara " + to_string(cabecalhoE) + " arestas, lidas "
+                                + to_string(total));
+        }
+        vertices = (int)cabecalhoV;
+    }
+
+    vector<Aresta> arestas;
+    if (numBlocos == 1) {
+        arestas = std::move(blocos[0].arestas);
+    } else {
+        arestas.reserve(total);
+        for (auto& bloco : blocos) {
+            arestas.insert(arestas.end(), bloco.arestas.begin(), bloco.arestas.end());
+            vector<Aresta>().swap(bloco.arestas);
+        }
+    }
+    return GrafoDirecionadoPonderado(vertices, std::move(arestas));
+}
@@ -0,0 +1,111 @@
+#include "MedidorMemoria.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#ifdef CONTAR_ALOCACOES
+#include <atomic>
+#include <new>
+
+static std::atomic<long long> totalAlocacoes{0};
+static std::atomic<long long> totalBytes{0};
+
+static void* alocar(std::size_t tamanho) {
+    totalAlocacoes.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add((long long)tamanho, std::memory_order_relaxed);
+    return std::malloc(tamanho ? tamanho : 1);
+}
+
+static void* alocarAlinhado(std::size_t tamanho, std::align_val_t alinhamento) {
+    totalAlocacoes.fetch_add(1, std::memory_order_relaxed);
+    totalBytes.fetch_add((long long)tamanho, std::memory_order_relaxed);
+    std::size_t a = (std::size_t)alinhamento;
+    return std::aligned_alloc(a, (tamanho + a - 1) / a * a);
+}
+
+void* operator new(std::size_t n) {
+    if (void* p = alocar(n)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n) {
+    if (void* p = alocar(n)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept { return alocar(n); }
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept { return alocar(n); }
+void* operator new(std::size_t n, std::align_val_t a) {
+    if (void* p = alocarAlinhado(n, a)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n, std::align_val_t a) {
+    if (void* p = alocarAlinhado(n, a)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+#endif
+
+long MedidorMemoria::statusKB(const char* campo) {
+    FILE* f = fopen("/proc/self/status", "r");
+    if (!f) return -1;
+    char linha[256];
+    long valor = -1;
+    size_t tamanho = strlen(campo);
+    while (fgets(linha, sizeof(linha), f)) {
+        if (strncmp(linha, campo, tamanho) == 0 && linha[tamanho] == ':') {
+            valor = strtol(linha + tamanho + 1, nullptr, 10);
+            break;
+        }
+    }
+    fclose(f);
+    return valor;
+}
+
+bool MedidorMemoria::reiniciarPico() {
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool ok = fputs("5", f) >= 0;
+    return fclose(f) == 0 && ok;
+}
+
+void MedidorMemoria::devolverMemoriaLivre() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+bool MedidorMemoria::contandoAlocacoes() {
+#ifdef CONTAR_ALOCACOES
+    return true;
+#else
+    return false;
+#endif
+}
+
+long long MedidorMemoria::alocacoes() {
+#ifdef CONTAR_ALOCACOES
+    return totalAlocacoes.load(std::memory_order_relaxed);
+#else
+    return -1;
+#endif
+}
+
+long long MedidorMemoria::bytesAlocados() {
+#ifdef CONTAR_ALOCACOES
+    return totalBytes.load(std::memory_order_relaxed);
+#else
+    return -1;
+#endif
+}
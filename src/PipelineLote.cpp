@@ -0,0 +1,185 @@
+#include "PipelineLote.h"
+#include "FilaLimitada.h"
+#include "SeletorMetodo.h"
+#include "Rastreamento.h"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <stdexcept>
+
+using namespace std::chrono;
+
+typedef FilaLimitada<ItemPipeline> FilaItens;
+
+PipelineLote::PipelineLote(const ConfigLote& config, const std::vector<std::string>& entradas, const std::vector<std::string>& saidas)
+    : config(config), entradas(entradas), saidas(saidas) {}
+
+std::unique_ptr<SegmentadorImagem> PipelineLote::obterSegmentador() {
+    {
+        std::lock_guard<std::mutex> trava(mutexLivres);
+        if (!segmentadoresLivres.empty()) {
+            std::unique_ptr<SegmentadorImagem> seg = std::move(segmentadoresLivres.back());
+            segmentadoresLivres.pop_back();
+            return seg;
+        }
+    }
+    std::unique_ptr<SegmentadorImagem> seg(new SegmentadorImagem());
+    seg->setVerboso(false);
+    seg->setDiretorioCache(config.diretorioCache);
+    seg->setOrdemSupernos(config.ordem);
+    seg->setSuperpixelsAlvo(config.superpixels);
+    seg->setNiveisPiramide(config.piramide);
+    seg->setRegiaoInteresse(config.regiao);
+    return seg;
+}
+
+void PipelineLote::devolverSegmentador(std::unique_ptr<SegmentadorImagem> seg) {
+    std::lock_guard<std::mutex> trava(mutexLivres);
+    segmentadoresLivres.push_back(std::move(seg));
+}
+
+ResultadoLote PipelineLote::executar() {
+    const int numEstagios = 5;
+    const char* nomes[numEstagios] = {"decodificacao", "suavizacao", "grafo", "solver", "rotulos+codificacao"};
+    const int threadsPorEstagio = config.trabalhadores < 1 ? 1 : config.trabalhadores;
+    const size_t capacidade = 2 * threadsPorEstagio;
+
+    // filas[k] liga o estagio k ao estagio k+1
+    std::vector<std::unique_ptr<FilaItens>> filas;
+    for (int k = 0; k < numEstagios - 1; ++k) filas.emplace_back(new FilaItens(capacidade));
+
+    std::atomic<long long> ocupadoNs[numEstagios];
+    std::atomic<int> threadsAtivas[numEstagios];
+    for (int k = 0; k < numEstagios; ++k) {
+        ocupadoNs[k] = 0;
+        threadsAtivas[k] = threadsPorEstagio;
+    }
+
+    // Espaco do solver por thread do estagio de resolucao
+    std::vector<EspacoTrabalhoArborescencia> espacos(threadsPorEstagio);
+
+    std::atomic<size_t> proximaEntrada(0);
+    std::atomic<int> processadas(0), falhas(0);
+    std::atomic<long long> pixels(0);
+    std::mutex mutexLog;
+
+    auto registrarFalha = [&](ItemPipeline& item, const std::string& motivo) {
+        falhas++;
+        {
+            std::lock_guard<std::mutex> trava(mutexLog);
+            std::cerr << "[ERRO] " << entradas[item.indice] << ": " << motivo << "\n";
+        }
+        item.grafo.reset();
+        item.resultado.reset();
+        devolverSegmentador(std::move(item.seg));
+    };
+
+    // Trabalho de cada estagio (recebe o indice da thread dentro do estagio);
+    // retorna false se o item deve ser descartado
+    std::function<bool(ItemPipeline&, int)> etapas[numEstagios] = {
+        [&](ItemPipeline& item, int idThread) {
+            return item.seg->carregarImagem(entradas[item.indice]);
+        },
+        [&](ItemPipeline& item, int idThread) {
+            item.seg->aplicarSuavizacao();
+            return true;
+        },
+        [&](ItemPipeline& item, int idThread) {
+            item.grafo.reset(new GrafoNaoDirecionadoPonderado(item.seg->criarGrafo()));
+            return true;
+        },
+        [&](ItemPipeline& item, int idThread) {
+            int raiz = item.seg->supernoRaiz(config.raiz);
+            item.resultado.reset(new GrafoDirecionadoPonderado(SeletorMetodo::resolver(config.metodo, *item.grafo, raiz, &espacos[idThread], config.heap)));
+            if (config.verificar) {
+                ResultadoVerificacao v = SeletorMetodo::verificar(config.metodo, *item.grafo, raiz, *item.resultado, &espacos[idThread]);
+                if (!v.otimo) throw std::runtime_error("resultado nao e otimo: " + v.motivo);
+            }
+            item.grafo.reset();
+            return true;
+        },
+        [&](ItemPipeline& item, int idThread) {
+            if (!item.seg->salvarSegmentacao(*item.resultado, saidas[item.indice], config.limiar, config.opcoesSaida))
+                throw std::runtime_error("falha ao gravar " + saidas[item.indice]);
+            pixels += (long long)item.seg->getLargura() * item.seg->getAltura();
+            processadas++;
+            item.resultado.reset();
+            devolverSegmentador(std::move(item.seg));
+            return true;
+        },
+    };
+
+    auto executarEtapa = [&](int k, int idThread, ItemPipeline& item) {
+        EscopoRastro rastro(nomes[k], entradas[item.indice].c_str());
+        auto inicio = steady_clock::now();
+        bool ok;
+        try {
+            ok = etapas[k](item, idThread);
+            if (!ok) registrarFalha(item, std::string("falha no estagio de ") + nomes[k]);
+        } catch (const std::exception& e) {
+            registrarFalha(item, e.what());
+            ok = false;
+        }
+        ocupadoNs[k] += duration_cast<nanoseconds>(steady_clock::now() - inicio).count();
+        return ok;
+    };
+
+    auto laco = [&](int k, int idThread) {
+        Rastreamento::nomearThread(std::string(nomes[k]) + " " + std::to_string(idThread));
+        ItemPipeline item;
+        while (true) {
+            if (k == 0) {
+                size_t i = proximaEntrada++;
+                if (i >= entradas.size()) break;
+                item.indice = i;
+                item.seg = obterSegmentador();
+            } else {
+                EscopoRastro rastroEspera("espera");
+                if (!filas[k - 1]->retirar(item)) break;
+            }
+
+            if (executarEtapa(k, idThread, item) && k < numEstagios - 1) {
+                filas[k]->inserir(std::move(item));
+            }
+        }
+
+        // A ultima thread do estagio fecha a fila de saida
+        if (--threadsAtivas[k] == 0 && k < numEstagios - 1) filas[k]->fechar();
+    };
+
+    std::cout << "Processando " << entradas.size() << " imagens em pipeline de " << numEstagios
+              << " estagios (" << threadsPorEstagio << " threads por estagio)...\n";
+
+    auto inicio = steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int k = 0; k < numEstagios; ++k)
+        for (int t = 0; t < threadsPorEstagio; ++t)
+            threads.emplace_back(laco, k, t);
+    for (auto& t : threads) t.join();
+
+    double segundos = duration<double>(steady_clock::now() - inicio).count();
+
+    ResultadoLote resultado;
+    resultado.processadas = processadas;
+    resultado.falhas = falhas;
+    resultado.megapixels = pixels / 1e6;
+    resultado.segundos = segundos;
+
+    for (int k = 0; k < numEstagios; ++k) {
+        EstatisticaEstagio e;
+        e.nome = nomes[k];
+        e.threads = threadsPorEstagio;
+        e.utilizacao = segundos > 0 ? (ocupadoNs[k] / 1e9) / (threadsPorEstagio * segundos) : 0.0;
+        if (k > 0) {
+            e.capacidadeFila = filas[k - 1]->getCapacidade();
+            e.filaMaxima = filas[k - 1]->profundidadeMaxima();
+            e.filaMedia = filas[k - 1]->profundidadeMedia();
+        }
+        resultado.estagios.push_back(e);
+    }
+
+    return resultado;
+}
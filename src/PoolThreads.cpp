@@ -0,0 +1,59 @@
+#include "PoolThreads.h"
+#include "Rastreamento.h"
+#include <string>
+
+PoolThreads::PoolThreads(int numTrabalhadores) : pendentes(0), encerrando(false) {
+    if (numTrabalhadores < 1) numTrabalhadores = 1;
+    for (int i = 0; i < numTrabalhadores; ++i) {
+        trabalhadores.emplace_back(&PoolThreads::laco, this, i);
+    }
+}
+
+PoolThreads::~PoolThreads() {
+    {
+        std::lock_guard<std::mutex> trava(mutex);
+        encerrando = true;
+    }
+    temTarefa.notify_all();
+    for (auto& t : trabalhadores) t.join();
+}
+
+void PoolThreads::enfileirar(std::function<void(int)> tarefa) {
+    {
+        std::lock_guard<std::mutex> trava(mutex);
+        tarefas.push(std::move(tarefa));
+        pendentes++;
+    }
+    temTarefa.notify_one();
+}
+
+void PoolThreads::aguardar() {
+    std::unique_lock<std::mutex> trava(mutex);
+    semPendentes.wait(trava, [this] { return pendentes == 0; });
+}
+
+int PoolThreads::numTrabalhadores() const {
+    return (int)trabalhadores.size();
+}
+
+void PoolThreads::laco(int idTrabalhador) {
+    Rastreamento::nomearThread("trabalhador " + std::to_string(idTrabalhador));
+    while (true) {
+        std::function<void(int)> tarefa;
+        {
+            std::unique_lock<std::mutex> trava(mutex);
+            temTarefa.wait(trava, [this] { return encerrando || !tarefas.empty(); });
+            if (tarefas.empty()) return; // encerrando e sem trabalho restante
+            tarefa = std::move(tarefas.front());
+            tarefas.pop();
+        }
+
+        tarefa(idTrabalhador);
+
+        {
+            std::lock_guard<std::mutex> trava(mutex);
+            pendentes--;
+            if (pendentes == 0) semPendentes.notify_all();
+        }
+    }
+}
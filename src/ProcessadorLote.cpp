@@ -0,0 +1,150 @@
+#include "ProcessadorLote.h"
+#include "PoolThreads.h"
+#include "PipelineLote.h"
+#include "SegmentadorImagem.h"
+#include "SeletorMetodo.h"
+#include "Rastreamento.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+ProcessadorLote::ProcessadorLote(const ConfigLote& config) : config(config) {}
+
+static bool extensaoImagem(const fs::path& caminho) {
+    std::string ext = caminho.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png" || ext == ".bmp" ||
+           ext == ".tga" || ext == ".ppm" || ext == ".pgm" || ext == ".gif";
+}
+
+std::vector<std::string> ProcessadorLote::listarEntradas(const std::string& entrada) {
+    std::vector<std::string> caminhos;
+
+    if (fs::is_directory(entrada)) {
+        for (const auto& item : fs::directory_iterator(entrada)) {
+            if (item.is_regular_file() && extensaoImagem(item.path()))
+                caminhos.push_back(item.path().string());
+        }
+        std::sort(caminhos.begin(), caminhos.end());
+    } else {
+        std::ifstream lista(entrada);
+        if (!lista) throw std::runtime_error("Nao foi possivel abrir a entrada do lote: " + entrada);
+
+        std::string linha;
+        while (std::getline(lista, linha)) {
+            if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+            if (!linha.empty()) caminhos.push_back(linha);
+        }
+    }
+
+    return caminhos;
+}
+
+std::vector<std::string> ProcessadorLote::nomesSaida(const std::vector<std::string>& entradas, const std::string& diretorio,
+                                                     const char* nomeMetodo, FormatoSaida formato) {
+    // Imagens de diretorios diferentes podem ter o mesmo nome: acrescenta um sufixo
+    std::map<std::string, int> usos;
+    std::vector<std::string> nomes;
+    nomes.reserve(entradas.size());
+
+    for (const auto& entrada : entradas) {
+        std::string base = fs::path(entrada).stem().string();
+        int n = usos[base]++;
+        if (n > 0) base += "_" + std::to_string(n);
+
+        fs::path saida = fs::path(diretorio) / (base + "_" + nomeMetodo + "." + EscritorSaida::extensao(formato));
+        nomes.push_back(saida.string());
+    }
+    return nomes;
+}
+
+ResultadoLote ProcessadorLote::executar() {
+    using namespace std::chrono;
+
+    if (!SeletorMetodo::valido(config.metodo))
+        throw std::runtime_error("Metodo invalido. Escolha um metodo de 0 a 4.");
+    if (config.verificar) SeletorMetodo::exigirVerificavel(config.metodo);
+
+    std::vector<std::string> entradas = listarEntradas(config.entrada);
+    fs::create_directories(config.diretorioSaida);
+    if (!config.diretorioCache.empty()) fs::create_directories(config.diretorioCache);
+    std::vector<std::string> saidas = nomesSaida(entradas, config.diretorioSaida,
+                                                 SeletorMetodo::nome(config.metodo), config.opcoesSaida.formato);
+
+    if (config.pipeline) {
+        PipelineLote pipeline(config, entradas, saidas);
+        return pipeline.executar();
+    }
+
+    PoolThreads pool(config.trabalhadores);
+
+    // Buffers por trabalhador: cada thread so acessa o seu segmentador e espaco do solver
+    std::vector<std::unique_ptr<SegmentadorImagem>> segmentadores;
+    std::vector<EspacoTrabalhoArborescencia> espacos(pool.numTrabalhadores());
+    for (int i = 0; i < pool.numTrabalhadores(); ++i) {
+        segmentadores.emplace_back(new SegmentadorImagem());
+        segmentadores.back()->setVerboso(false);
+        segmentadores.back()->setDiretorioCache(config.diretorioCache);
+        segmentadores.back()->setOrdemSupernos(config.ordem);
+        segmentadores.back()->setSuperpixelsAlvo(config.superpixels);
+        segmentadores.back()->setNiveisPiramide(config.piramide);
+        segmentadores.back()->setRegiaoInteresse(config.regiao);
+    }
+
+    std::atomic<int> processadas(0), falhas(0);
+    std::atomic<long long> pixels(0);
+    std::mutex mutexLog;
+
+    std::cout << "Processando " << entradas.size() << " imagens com "
+              << pool.numTrabalhadores() << " trabalhadores...\n";
+
+    auto inicio = steady_clock::now();
+
+    for (size_t i = 0; i < entradas.size(); ++i) {
+        pool.enfileirar([&, i](int idTrabalhador) {
+            SegmentadorImagem& seg = *segmentadores[idTrabalhador];
+            EscopoRastro rastro("imagem", entradas[i].c_str());
+            try {
+                if (!seg.carregarImagem(entradas[i]))
+                    throw std::runtime_error("falha ao carregar");
+
+                seg.aplicarSuavizacao();
+                GrafoNaoDirecionadoPonderado grafo = seg.criarGrafo();
+                int raiz = seg.supernoRaiz(config.raiz);
+                GrafoDirecionadoPonderado resultado = SeletorMetodo::resolver(config.metodo, grafo, raiz, &espacos[idTrabalhador], config.heap);
+                if (config.verificar) {
+                    ResultadoVerificacao v = SeletorMetodo::verificar(config.metodo, grafo, raiz, resultado, &espacos[idTrabalhador]);
+                    if (!v.otimo) throw std::runtime_error("resultado nao e otimo: " + v.motivo);
+                }
+                if (!seg.salvarSegmentacao(resultado, saidas[i], config.limiar, config.opcoesSaida))
+                    throw std::runtime_error("falha ao gravar " + saidas[i]);
+
+                pixels += (long long)seg.getLargura() * seg.getAltura();
+                processadas++;
+            } catch (const std::exception& e) {
+                falhas++;
+                std::lock_guard<std::mutex> trava(mutexLog);
+                std::cerr << "[ERRO] " << entradas[i] << ": " << e.what() << "\n";
+            }
+        });
+    }
+    pool.aguardar();
+
+    auto fim = steady_clock::now();
+
+    ResultadoLote resultado;
+    resultado.processadas = processadas;
+    resultado.falhas = falhas;
+    resultado.megapixels = pixels / 1e6;
+    resultado.segundos = duration<double>(fim - inicio).count();
+    return resultado;
+}
@@ -0,0 +1,135 @@
+#include "ProcessadorSequencia.h"
+#include "ProcessadorLote.h"
+#include "SeletorMetodo.h"
+#include "AlgoritmoKruskal.h"
+#include "EspacoTrabalhoArborescencia.h"
+#include "Rastreamento.h"
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+ProcessadorSequencia::ProcessadorSequencia(const ConfigSequencia& config) : config(config) {}
+
+static bool menorPeso(const Aresta& a, const Aresta& b) {
+    return a.peso < b.peso;
+}
+
+static double pesoTotal(const GrafoDirecionadoPonderado& resultado) {
+    double peso = 0.0;
+    for (const auto& a : resultado.getTodasArestas()) peso += a.peso;
+    return peso;
+}
+
+// Partida a quente do Kruskal: as arestas entre superpixels mantidos conservam
+// o peso, então a ordem do quadro anterior continua valendo para elas; só as
+// que tocam superpixels novos são ordenadas, e as duas listas são intercaladas
+static void atualizarOrdemKruskal(const GrafoNaoDirecionadoPonderado& grafo, const AtualizacaoGrafo& info,
+                                  std::vector<Aresta>& ordenadas) {
+    EscopoRastro rastro("kruskal:ordenacao");
+    if (info.completa) {
+        ordenadas = grafo.getTodasArestas();
+        std::sort(ordenadas.begin(), ordenadas.end(), menorPeso);
+        return;
+    }
+
+    std::vector<Aresta> mantidas, novas;
+    mantidas.reserve(ordenadas.size());
+    for (const auto& a : ordenadas) {
+        int u = info.idNovo[a.origem], v = info.idNovo[a.destino];
+        if (u >= 0 && v >= 0) mantidas.emplace_back(u, v, a.peso);
+    }
+    for (const auto& a : grafo.getTodasArestas()) {
+        if (a.origem >= info.supernosMantidos || a.destino >= info.supernosMantidos) novas.push_back(a);
+    }
+    std::sort(novas.begin(), novas.end(), menorPeso);
+
+    ordenadas.clear();
+    ordenadas.reserve(mantidas.size() + novas.size());
+    std::merge(mantidas.begin(), mantidas.end(), novas.begin(), novas.end(), std::back_inserter(ordenadas), menorPeso);
+}
+
+std::vector<QuadroSequencia> ProcessadorSequencia::executar() {
+    using namespace std::chrono;
+
+    if (!SeletorMetodo::valido(config.metodo))
+        throw std::runtime_error("Metodo invalido. Escolha um metodo de 0 a 4.");
+    if (config.verificar) SeletorMetodo::exigirVerificavel(config.metodo);
+    if (config.ladrilho < 1) throw std::runtime_error("Ladrilho deve ter ao menos 1 pixel.");
+
+    std::vector<std::string> entradas = ProcessadorLote::listarEntradas(config.entrada);
+    fs::create_directories(config.diretorioSaida);
+    std::vector<std::string> saidas = ProcessadorLote::nomesSaida(entradas, config.diretorioSaida,
+                                                                  SeletorMetodo::nome(config.metodo), config.opcoesSaida.formato);
+
+    SegmentadorImagem seg, segCompleto;
+    for (SegmentadorImagem* s : {&seg, &segCompleto}) {
+        s->setVerboso(false);
+        s->setNiveisPiramide(config.piramide);
+        s->setRegiaoInteresse(config.regiao);
+    }
+    EspacoTrabalhoArborescencia espaco;
+    std::vector<Aresta> ordenadas; // Kruskal: arestas do quadro anterior em ordem de peso
+
+    std::vector<QuadroSequencia> quadros;
+    for (size_t i = 0; i < entradas.size(); ++i) {
+        EscopoRastro rastro("quadro", entradas[i].c_str());
+        QuadroSequencia q;
+        q.caminho = entradas[i];
+        try {
+            if (!seg.carregarImagem(entradas[i])) throw std::runtime_error("falha ao carregar");
+            seg.aplicarSuavizacao();
+
+            auto inicio = steady_clock::now();
+            AtualizacaoGrafo info;
+            GrafoNaoDirecionadoPonderado grafo = seg.criarGrafoIncremental(config.ladrilho, config.tolerancia, info);
+            int raiz = seg.supernoRaiz(config.raiz);
+            GrafoDirecionadoPonderado resultado(0);
+            if (config.metodo == 1) {
+                atualizarOrdemKruskal(grafo, info, ordenadas);
+                AlgoritmoKruskal kruskal;
+                EscopoRastro rastroKruskal("resolver", "kruskal");
+                resultado = kruskal.encontrarMST(grafo.numVertices(), ordenadas);
+            } else {
+                resultado = SeletorMetodo::resolver(config.metodo, grafo, raiz, &espaco, config.heap);
+            }
+            q.msIncremental = duration<double, std::milli>(steady_clock::now() - inicio).count();
+
+            if (config.verificar) {
+                ResultadoVerificacao v = SeletorMetodo::verificar(config.metodo, grafo, raiz, resultado, &espaco);
+                if (!v.otimo) throw std::runtime_error("resultado nao e otimo: " + v.motivo);
+            }
+            if (!seg.salvarSegmentacao(resultado, saidas[i], config.limiar, config.opcoesSaida))
+                throw std::runtime_error("falha ao gravar " + saidas[i]);
+
+            q.completo = info.completa;
+            q.fracaoAlterada = info.completa ? 1.0 : (double)info.ladrilhosAlterados / std::max(1, info.ladrilhosTotal);
+            q.fracaoReagrupada = info.completa ? 1.0
+                : (double)info.pixelsReagrupados / std::max(1, seg.getLargura() * seg.getAltura());
+            q.supernos = grafo.numVertices();
+            q.supernosMantidos = info.supernosMantidos;
+            q.peso = pesoTotal(resultado);
+
+            if (config.comparar) {
+                EscopoRastro rastroCompleto("quadro:completo");
+                if (!segCompleto.carregarImagem(entradas[i])) throw std::runtime_error("falha ao carregar");
+                segCompleto.aplicarSuavizacao();
+                inicio = steady_clock::now();
+                GrafoNaoDirecionadoPonderado grafoCompleto = segCompleto.criarGrafo();
+                GrafoDirecionadoPonderado r = SeletorMetodo::resolver(config.metodo, grafoCompleto,
+                                                                      segCompleto.supernoRaiz(config.raiz), &espaco, config.heap);
+                q.msCompleto = duration<double, std::milli>(steady_clock::now() - inicio).count();
+                q.pesoCompleto = pesoTotal(r);
+            }
+            q.ok = true;
+        } catch (const std::exception& e) {
+            std::cerr << "[ERRO] " << entradas[i] << ": " << e.what() << "\n";
+        }
+        quadros.push_back(q);
+    }
+    return quadros;
+}
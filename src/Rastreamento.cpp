@@ -0,0 +1,106 @@
+#include "Rastreamento.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> Rastreamento::ligado(false);
+
+struct EventoRastro {
+    const char* nome;
+    std::string detalhe;
+    int64_t inicioNs;
+    int64_t duracaoNs;
+};
+
+// Buffers nunca são liberados antes do fim do programa: threads que já
+// terminaram continuam com os seus eventos disponíveis para salvar()
+struct BufferThread {
+    int id = 0;
+    std::string nome;
+    std::vector<EventoRastro> eventos;
+};
+
+static std::mutex mutexBuffers;
+static std::vector<std::unique_ptr<BufferThread>> buffers;
+static std::chrono::steady_clock::time_point origem;
+static thread_local BufferThread* bufferLocal = nullptr;
+
+static BufferThread& bufferDaThread() {
+    if (!bufferLocal) {
+        std::lock_guard<std::mutex> trava(mutexBuffers);
+        buffers.emplace_back(new BufferThread());
+        bufferLocal = buffers.back().get();
+        bufferLocal->id = (int)buffers.size();
+        bufferLocal->eventos.reserve(1024);
+    }
+    return *bufferLocal;
+}
+
+static void escreverTextoJSON(FILE* f, const std::string& texto) {
+    fputc('"', f);
+    for (unsigned char c : texto) {
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+void Rastreamento::iniciar() {
+    origem = std::chrono::steady_clock::now();
+    ligado.store(true, std::memory_order_relaxed);
+}
+
+void Rastreamento::nomearThread(const std::string& nome) {
+    if (ativo()) bufferDaThread().nome = nome;
+}
+
+int64_t Rastreamento::agoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origem).count();
+}
+
+void Rastreamento::registrar(const char* nome, const char* detalhe, int64_t inicioNs, int64_t fimNs) {
+    BufferThread& buffer = bufferDaThread();
+    buffer.eventos.push_back({nome, detalhe ? detalhe : "", inicioNs, fimNs - inicioNs});
+}
+
+bool Rastreamento::salvar(const std::string& caminho) {
+    ligado.store(false, std::memory_order_relaxed);
+
+    FILE* f = fopen(caminho.c_str(), "w");
+    if (!f) return false;
+
+    std::lock_guard<std::mutex> trava(mutexBuffers);
+    bool primeiro = true;
+    auto separar = [&]() {
+        if (!primeiro) fputs(",\n", f);
+        primeiro = false;
+    };
+
+    // Eventos completos ("X"): tempos em microssegundos, uma trilha por thread
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    for (const auto& buffer : buffers) {
+        if (!buffer->nome.empty()) {
+            separar();
+            fprintf(f, "{\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":", buffer->id);
+            escreverTextoJSON(f, buffer->nome);
+            fputs("}}", f);
+        }
+        for (const auto& e : buffer->eventos) {
+            separar();
+            fprintf(f, "{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"name\":", buffer->id,
+                    e.inicioNs / 1e3, e.duracaoNs / 1e3);
+            escreverTextoJSON(f, e.nome);
+            if (!e.detalhe.empty()) {
+                fputs(",\"args\":{\"detalhe\":", f);
+                escreverTextoJSON(f, e.detalhe);
+                fputc('}', f);
+            }
+            fputc('}', f);
+        }
+    }
+    fputs("\n]}\n", f);
+    return fclose(f) == 0;
+}
@@ -3,29 +3,179 @@
 #include <iostream>
 #include <cmath>
 #include <queue>
-#include <map>
-#include <set>
+#include <random>
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <memory>
+#include "ArquivoMapeado.h"
+#include "Rastreamento.h"
+#include "PoolThreads.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb_image_write.h"
 
-SegmentadorImagem::SegmentadorImagem() : dadosImagem(nullptr), largura(0), altura(0), canais(0) {}
+// Parâmetros de criarGrafo; entram na chave do cache
+static const double LIMIAR_AGRUPAMENTO = 15.0;
+static const double MAX_PESO = 441.67;
+static const uint32_t VERSAO_CACHE_GRAFO = 2;
+
+// Parâmetros do SLIC (setSuperpixelsAlvo); também entram na chave do cache
+static const int ITERACOES_SLIC = 10;
+static const double COMPACIDADE_SLIC = 10.0;
+
+// Raio do kernel de aplicarSuavizacao: margem lida em volta da região de interesse
+static const int HALO_SUAVIZACAO = 1;
+
+// FNV-1a de 64 bits
+static uint64_t fnv1a(const void* dados, size_t tamanho, uint64_t hash = 14695981039346656037ull) {
+    const unsigned char* p = (const unsigned char*)dados;
+    for (size_t i = 0; i < tamanho; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Monta o grafo simétrico a partir do CSR por origem, com o construtor em bloco
+static GrafoNaoDirecionadoPonderado grafoDoCSR(int numSupernos, const uint32_t* inicio, const uint32_t* destino, const double* peso) {
+    std::vector<Aresta> arestas;
+    arestas.reserve(inicio[numSupernos]);
+    for (int u = 0; u < numSupernos; ++u) {
+        for (uint32_t k = inicio[u]; k < inicio[u + 1]; ++k)
+            arestas.emplace_back(u, (int)destino[k], peso[k]);
+    }
+    return GrafoNaoDirecionadoPonderado(numSupernos, std::move(arestas));
+}
+
+// Índice de (x, y) na curva de Hilbert de um grid n x n (n potência de 2)
+static uint64_t indiceHilbert(uint32_t n, uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        // Rotaciona o quadrante para que a curva continue contínua
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+// Índice de Morton (Z-order): bits de x e y intercalados
+static uint64_t indiceMorton(uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (int b = 0; b < 32; ++b) {
+        d |= (uint64_t)((x >> b) & 1) << (2 * b);
+        d |= (uint64_t)((y >> b) & 1) << (2 * b + 1);
+    }
+    return d;
+}
+
+SegmentadorImagem::SegmentadorImagem()
+    : dadosImagem(nullptr), largura(0), altura(0), canais(0), larguraCheia(0), alturaCheia(0), niveisPiramide(0),
+      haloEsquerda(0), haloTopo(0), haloDireita(0), haloBase(0),
+      verboso(true), ordem(OrdemSupernos::VARREDURA), superpixelsAlvo(0), threadsSLIC(1), larguraReferencia(0) {}
 
 SegmentadorImagem::~SegmentadorImagem() {
     if (dadosImagem) stbi_image_free(dadosImagem);
 }
 
 bool SegmentadorImagem::carregarImagem(const std::string& caminho) {
+    EscopoRastro rastro("carregarImagem", caminho.c_str());
+
+    // Permite reutilizar o mesmo segmentador para varias imagens
+    if (dadosImagem) {
+        stbi_image_free(dadosImagem);
+        dadosImagem = nullptr;
+    }
+
+    // A stb_image só decodifica a imagem inteira; a região de interesse é
+    // recortada depois, no próprio buffer
     dadosImagem = stbi_load(caminho.c_str(), &largura, &altura, &canais, 3);
     if (!dadosImagem) {
         std::cerr << "Erro ao carregar imagem: " << caminho << std::endl;
         return false;
     }
+    haloEsquerda = haloTopo = haloDireita = haloBase = 0;
+
+    if (!regiaoInteresse.inteira()) {
+        const RegiaoInteresse& r = regiaoInteresse;
+        int x0 = std::max(0, r.x), y0 = std::max(0, r.y);
+        int x1 = std::min(largura, r.x + r.largura), y1 = std::min(altura, r.y + r.altura);
+        if (x0 >= x1 || y0 >= y1) {
+            std::cerr << "Regiao de interesse fora da imagem: " << caminho << std::endl;
+            return false;
+        }
+        haloEsquerda = std::min(HALO_SUAVIZACAO, x0);
+        haloTopo = std::min(HALO_SUAVIZACAO, y0);
+        haloDireita = std::min(HALO_SUAVIZACAO, largura - x1);
+        haloBase = std::min(HALO_SUAVIZACAO, altura - y1);
+        EscopoRastro rastroRecorte("recortarRegiao");
+        recortar(x0 - haloEsquerda, y0 - haloTopo, x1 - x0 + haloEsquerda + haloDireita, y1 - y0 + haloTopo + haloBase);
+    }
+
+    larguraCheia = largura - haloEsquerda - haloDireita;
+    alturaCheia = altura - haloTopo - haloBase;
+    if (niveisPiramide > 0) {
+        // Na escala reduzida a suavização é outra; a margem não serve mais
+        removerHalo();
+        reduzirPiramide();
+    }
     return true;
 }
 
+// Mantém só o retângulo dado de dadosImagem, no próprio buffer: cada linha vai
+// para uma posição anterior (ou igual) à de origem
+void SegmentadorImagem::recortar(int x0, int y0, int novaLargura, int novaAltura) {
+    for (int y = 0; y < novaAltura; ++y) {
+        std::memmove(&dadosImagem[(size_t)y * novaLargura * 3], &dadosImagem[((size_t)(y0 + y) * largura + x0) * 3],
+                     (size_t)novaLargura * 3);
+    }
+    largura = novaLargura;
+    altura = novaAltura;
+}
+
+void SegmentadorImagem::removerHalo() {
+    if (haloEsquerda + haloTopo + haloDireita + haloBase == 0) return;
+    recortar(haloEsquerda, haloTopo, largura - haloEsquerda - haloDireita, altura - haloTopo - haloBase);
+    haloEsquerda = haloTopo = haloDireita = haloBase = 0;
+}
+
+// Guarda a imagem original e substitui dadosImagem (no próprio buffer) pela
+// média de cada bloco f x f, f = 2^niveis; blocos da borda podem ser menores
+void SegmentadorImagem::reduzirPiramide() {
+    EscopoRastro rastro("reduzirPiramide");
+    const int f = 1 << niveisPiramide;
+    imagemCheia.assign(dadosImagem, dadosImagem + (size_t)larguraCheia * alturaCheia * 3);
+    largura = (larguraCheia + f - 1) / f;
+    altura = (alturaCheia + f - 1) / f;
+
+    for (int by = 0; by < altura; ++by) {
+        for (int bx = 0; bx < largura; ++bx) {
+            int y1 = std::min(alturaCheia, (by + 1) * f), x1 = std::min(larguraCheia, (bx + 1) * f);
+            int soma[3] = {0, 0, 0}, n = 0;
+            for (int y = by * f; y < y1; ++y) {
+                const unsigned char* px = &imagemCheia[((size_t)y * larguraCheia + bx * f) * 3];
+                for (int x = bx * f; x < x1; ++x, px += 3, ++n) {
+                    soma[0] += px[0]; soma[1] += px[1]; soma[2] += px[2];
+                }
+            }
+            unsigned char* destino = &dadosImagem[getIndice(bx, by) * 3];
+            for (int c = 0; c < 3; ++c) destino[c] = (unsigned char)(soma[c] / n);
+        }
+    }
+}
+
 int SegmentadorImagem::getIndice(int x, int y) {
     return y * largura + x;
 }
@@ -50,7 +200,9 @@ double SegmentadorImagem::calcularDiferencaCorMedia(std::tuple<int,int,int> c1,
 
 void SegmentadorImagem::aplicarSuavizacao() {
     if (!dadosImagem) return;
-    std::vector<unsigned char> dadosSuavizados(largura * altura * 3);
+    EscopoRastro rastro("aplicarSuavizacao");
+    std::vector<unsigned char>& dadosSuavizados = bufferSuavizacao;
+    dadosSuavizados.resize(largura * altura * 3);
     
     // Kernel de vizinhança em cruz
     int dx[] = {0, 1, -1, 0, 0}; 
@@ -75,29 +227,56 @@ void SegmentadorImagem::aplicarSuavizacao() {
         }
     }
     std::copy(dadosSuavizados.begin(), dadosSuavizados.end(), dadosImagem);
+
+    // A margem da região de interesse só existia para esta média
+    removerHalo();
 }
 
-GrafoDirecionadoPonderado SegmentadorImagem::criarGrafo() {
+GrafoNaoDirecionadoPonderado SegmentadorImagem::criarGrafo() {
+    EscopoRastro rastro("criarGrafo");
+    removerHalo(); // Sem suavização, a margem da região de interesse ainda está lá
+    quadroReferencia.clear(); // Os superpixels deixam de corresponder à referência
     int numPixels = largura * altura;
-    
-    UnionFind uf(numPixels);
-    double limiarAgrupamento = 15.0; 
 
-    std::cout << "Agrupando pixels similares (Superpixels)...\n";
+    uint64_t chave = 0;
+    std::string caminhoCache;
+    if (!diretorioCache.empty()) {
+        chave = chaveCache();
+        char nome[32];
+        snprintf(nome, sizeof(nome), "%016llx.sgc", (unsigned long long)chave);
+        caminhoCache = diretorioCache + "/" + nome;
+
+        GrafoNaoDirecionadoPonderado grafo(0);
+        if (carregarCache(caminhoCache, chave, grafo)) {
+            if (verboso) std::cout << "Grafo de superpixels lido do cache: " << caminhoCache << "\n";
+            return grafo;
+        }
+    }
     
-    // Agrupa pixels vizinhos muito parecidos para reduzir o grafo
-    for (int y = 0; y < altura; ++y) {
-        for (int x = 0; x < largura; ++x) {
-            int u = getIndice(x, y);
-            int vizinhosX[] = {x + 1, x};
-            int vizinhosY[] = {y, y + 1};
+    EscopoRastro rastroSuperpixels("criarGrafo:superpixels");
+    UnionFind& uf = ufPixels;
+    uf.reiniciar(numPixels);
 
-            for(int i=0; i<2; ++i) {
-                int nx = vizinhosX[i], ny = vizinhosY[i];
-                if (nx < largura && ny < altura) {
-                    int v = getIndice(nx, ny);
-                    if (calcularDiferencaCor(u, v) < limiarAgrupamento) {
-                        uf.unite(u, v);
+    if (superpixelsAlvo > 0) {
+        if (verboso) std::cout << "Agrupando pixels (SLIC, alvo de " << superpixelsAlvo << " superpixels)...\n";
+        agruparSLIC(uf);
+    } else {
+        if (verboso) std::cout << "Agrupando pixels similares (Superpixels)...\n";
+
+        // Agrupa pixels vizinhos muito parecidos para reduzir o grafo
+        for (int y = 0; y < altura; ++y) {
+            for (int x = 0; x < largura; ++x) {
+                int u = getIndice(x, y);
+                int vizinhosX[] = {x + 1, x};
+                int vizinhosY[] = {y, y + 1};
+
+                for(int i=0; i<2; ++i) {
+                    int nx = vizinhosX[i], ny = vizinhosY[i];
+                    if (nx < largura && ny < altura) {
+                        int v = getIndice(nx, ny);
+                        if (calcularDiferencaCor(u, v) < LIMIAR_AGRUPAMENTO) {
+                            uf.unite(u, v);
+                        }
                     }
                 }
             }
@@ -105,17 +284,17 @@ GrafoDirecionadoPonderado SegmentadorImagem::criarGrafo() {
     }
 
     // Calcula a cor média de cada superpixel
-    std::map<int, int> rootToId;
+    rootToId.assign(numPixels, -1);
     int nextId = 0;
     
-    std::vector<long long> sumR(numPixels, 0), sumG(numPixels, 0), sumB(numPixels, 0);
-    std::vector<int> countPixel(numPixels, 0);
+    sumR.assign(numPixels, 0); sumG.assign(numPixels, 0); sumB.assign(numPixels, 0);
+    countPixel.assign(numPixels, 0);
 
     pixelParaSuperno.assign(numPixels, -1);
 
     for(int i=0; i<numPixels; ++i) {
         int root = uf.find(i);
-        if (rootToId.find(root) == rootToId.end()) {
+        if (rootToId[root] == -1) {
             rootToId[root] = nextId++;
         }
         int superNoId = rootToId[root];
@@ -134,13 +313,18 @@ GrafoDirecionadoPonderado SegmentadorImagem::criarGrafo() {
             coresSupernos[i] = {sumR[i]/countPixel[i], sumG[i]/countPixel[i], sumB[i]/countPixel[i]};
     }
 
-    std::cout << "Grafo Reduzido: " << numPixels << " pixels -> " << numSupernos << " supernos.\n";
+    rastroSuperpixels.encerrar();
 
-    // Constrói o grafo de adjacência entre superpixels
-    GrafoDirecionadoPonderado grafo(numSupernos);
-    const double MAX_PESO = 441.67;
+    if (ordem != OrdemSupernos::VARREDURA) {
+        EscopoRastro rastroRenumeracao("criarGrafo:renumeracao");
+        renumerarSupernos(numSupernos);
+    }
+    if (verboso) std::cout << "Grafo Reduzido: " << numPixels << " pixels -> " << numSupernos << " supernos.\n";
 
-    std::set<std::pair<int,int>> arestasAdicionadas;
+    // Constrói o grafo de adjacência entre superpixels: uma aresta por par
+    // (menor id -> maior id); os dois sentidos saem de getArcos()
+    EscopoRastro rastroArestas("criarGrafo:arestas");
+    std::vector<std::pair<int, int>> pares;
 
     for (int y = 0; y < altura; ++y) {
         for (int x = 0; x < largura; ++x) {
@@ -156,30 +340,550 @@ GrafoDirecionadoPonderado SegmentadorImagem::criarGrafo() {
                     int vPixel = getIndice(nx, ny);
                     int vSuper = pixelParaSuperno[vPixel];
 
-                    if (uSuper != vSuper) {
-                        // Evita duplicatas de arestas entre os mesmos supernos
-                        if (arestasAdicionadas.find({uSuper, vSuper}) == arestasAdicionadas.end()) {
-                            double peso = calcularDiferencaCorMedia(coresSupernos[uSuper], coresSupernos[vSuper]);
-                            double pesoNorm = peso / MAX_PESO;
-                            
-                            // Grafo bidirecional
-                            grafo.adicionarAresta(uSuper, vSuper, pesoNorm);
-                            grafo.adicionarAresta(vSuper, uSuper, pesoNorm); 
-                            
-                            arestasAdicionadas.insert({uSuper, vSuper});
-                            arestasAdicionadas.insert({vSuper, uSuper});
-                        }
-                    }
+                    if (uSuper != vSuper) pares.push_back(std::minmax(uSuper, vSuper));
                 }
             }
         }
     }
 
-    return grafo;
+    // Evita duplicatas de arestas entre os mesmos supernos. As arestas saem
+    // ordenadas por (origem, destino): com os ids em ordem espacial, vizinhos
+    // de um superpixel ficam contíguos e crescentes
+    std::sort(pares.begin(), pares.end());
+    pares.erase(std::unique(pares.begin(), pares.end()), pares.end());
+    std::vector<Aresta> arestas;
+    arestas.reserve(pares.size());
+    for (const auto& par : pares) {
+        double peso = calcularDiferencaCorMedia(coresSupernos[par.first], coresSupernos[par.second]);
+        arestas.emplace_back(par.first, par.second, peso / MAX_PESO);
+    }
+    rastroArestas.encerrar();
+
+    montarCSR(numSupernos, arestas);
+
+    if (!caminhoCache.empty()) {
+        if (salvarCache(caminhoCache, chave)) {
+            if (verboso) std::cout << "Grafo de superpixels salvo no cache: " << caminhoCache << "\n";
+        } else {
+            std::cerr << "Aviso: nao foi possivel gravar o cache " << caminhoCache << std::endl;
+        }
+    }
+
+    return grafoDoCSR(numSupernos, csrInicio.data(), csrDestino.data(), csrPeso.data());
+}
+
+// CSR por origem (counting sort estável); o grafo devolvido segue essa
+// ordem, de modo que o grafo lido do cache é idêntico ao construído
+void SegmentadorImagem::montarCSR(int numSupernos, const std::vector<Aresta>& arestas) {
+    csrInicio.assign(numSupernos + 1, 0);
+    for (const auto& a : arestas) csrInicio[a.origem + 1]++;
+    for (int u = 0; u < numSupernos; ++u) csrInicio[u + 1] += csrInicio[u];
+    csrDestino.resize(arestas.size());
+    csrPeso.resize(arestas.size());
+    std::vector<uint32_t> pos(csrInicio.begin(), csrInicio.end() - 1);
+    for (const auto& a : arestas) {
+        uint32_t k = pos[a.origem]++;
+        csrDestino[k] = a.destino;
+        csrPeso[k] = a.peso;
+    }
+}
+
+GrafoNaoDirecionadoPonderado SegmentadorImagem::criarGrafoIncremental(int ladrilho, int tolerancia, AtualizacaoGrafo& info) {
+    EscopoRastro rastro("criarGrafoIncremental");
+    removerHalo();
+    const int numPixels = largura * altura;
+    const size_t bytes = (size_t)numPixels * 3;
+    info = AtualizacaoGrafo();
+
+    // Renumeração e SLIC não conservam ids entre quadros: sempre do zero
+    if (quadroReferencia.size() != bytes || larguraReferencia != largura
+        || ordem != OrdemSupernos::VARREDURA || superpixelsAlvo > 0) {
+        GrafoNaoDirecionadoPonderado grafo = criarGrafo();
+        quadroReferencia.assign(dadosImagem, dadosImagem + bytes);
+        larguraReferencia = largura;
+        info.supernosMantidos = 0;
+        return grafo;
+    }
+    info.completa = false;
+
+    // Ladrilhos com algum canal fora da tolerância
+    EscopoRastro rastroLadrilhos("incremental:ladrilhos");
+    const int ladrilhosX = (largura + ladrilho - 1) / ladrilho, ladrilhosY = (altura + ladrilho - 1) / ladrilho;
+    info.ladrilhosTotal = ladrilhosX * ladrilhosY;
+    ladrilhoAlterado.assign(info.ladrilhosTotal, 0);
+    for (int y = 0; y < altura; ++y) {
+        char* linha = &ladrilhoAlterado[(y / ladrilho) * ladrilhosX];
+        for (int tx = 0; tx < ladrilhosX; ++tx) {
+            if (linha[tx]) continue;
+            size_t inicio = ((size_t)y * largura + (size_t)tx * ladrilho) * 3;
+            size_t fim = inicio + (size_t)std::min(ladrilho, largura - tx * ladrilho) * 3;
+            for (size_t b = inicio; b < fim; ++b) {
+                if (std::abs((int)dadosImagem[b] - (int)quadroReferencia[b]) > tolerancia) {
+                    linha[tx] = 1;
+                    info.ladrilhosAlterados++;
+                    break;
+                }
+            }
+        }
+    }
+    rastroLadrilhos.encerrar();
+
+    // Superpixels sujos: os que têm pixels em ladrilhos alterados. Todos os
+    // seus pixels são reagrupados; de cada superpixel limpo basta um representante.
+    EscopoRastro rastroAgrupamento("incremental:superpixels");
+    const int numSupernosAnterior = (int)coresSupernos.size();
+    supernoSujo.assign(numSupernosAnterior, 0);
+    for (int t = 0; t < info.ladrilhosTotal; ++t) {
+        if (!ladrilhoAlterado[t]) continue;
+        int x0 = (t % ladrilhosX) * ladrilho, y0 = (t / ladrilhosX) * ladrilho;
+        int x1 = std::min(largura, x0 + ladrilho), y1 = std::min(altura, y0 + ladrilho);
+        for (int y = y0; y < y1; ++y)
+            for (int x = x0; x < x1; ++x) supernoSujo[pixelParaSuperno[getIndice(x, y)]] = 1;
+    }
+
+    representante.assign(numSupernosAnterior, -1);
+    pixelsSujos.clear();
+    for (int i = 0; i < numPixels; ++i) {
+        int s = pixelParaSuperno[i];
+        if (supernoSujo[s]) pixelsSujos.push_back(i);
+        else if (representante[s] < 0) representante[s] = i;
+    }
+    info.pixelsReagrupados = (int)pixelsSujos.size();
+
+    // Elemento do union-find: o próprio pixel, se sujo, ou o representante
+    auto elemento = [&](int p) {
+        int s = pixelParaSuperno[p];
+        return supernoSujo[s] ? p : representante[s];
+    };
+
+    // Mesmo critério de criarGrafo nos pares com algum pixel sujo; pares sujo-sujo
+    // são vistos só para a direita e para baixo
+    UnionFind& uf = ufPixels;
+    uf.reiniciar(numPixels);
+    for (int p : pixelsSujos) {
+        int x = p % largura, y = p / largura;
+        int vizinhos[4] = {x + 1 < largura ? p + 1 : -1, y + 1 < altura ? p + largura : -1,
+                           x > 0 ? p - 1 : -1, y > 0 ? p - largura : -1};
+        for (int k = 0; k < 4; ++k) {
+            int q = vizinhos[k];
+            if (q < 0 || (k >= 2 && supernoSujo[pixelParaSuperno[q]])) continue;
+            if (calcularDiferencaCor(p, q) < LIMIAR_AGRUPAMENTO) uf.unite(p, elemento(q));
+        }
+    }
+
+    // Um superpixel limpo é mantido se o seu componente não ganhou mais nada
+    contagemComponente.assign(numPixels, 0);
+    for (int s = 0; s < numSupernosAnterior; ++s)
+        if (!supernoSujo[s]) contagemComponente[uf.find(representante[s])]++;
+    for (int p : pixelsSujos) contagemComponente[uf.find(p)] += 2;
+
+    info.idNovo.assign(numSupernosAnterior, -1);
+    int numSupernos = 0;
+    for (int s = 0; s < numSupernosAnterior; ++s) {
+        if (!supernoSujo[s] && contagemComponente[uf.find(representante[s])] == 1) info.idNovo[s] = numSupernos++;
+    }
+    info.supernosMantidos = numSupernos;
+
+    // Os mantidos conservam cor e tamanho; os novos componentes recebem ids a
+    // partir de supernosMantidos, pela ordem do primeiro pixel
+    std::vector<std::tuple<int, int, int>> cores(numSupernos);
+    std::vector<int> contagens(numSupernos);
+    for (int s = 0; s < numSupernosAnterior; ++s) {
+        if (info.idNovo[s] < 0) continue;
+        cores[info.idNovo[s]] = coresSupernos[s];
+        contagens[info.idNovo[s]] = countPixel[s];
+    }
+    sumR.clear(); sumG.clear(); sumB.clear();
+    idComponente.assign(numPixels, -1);
+    pixelsNovos.clear();
+    for (int i = 0; i < numPixels; ++i) {
+        int s = pixelParaSuperno[i];
+        if (!supernoSujo[s] && info.idNovo[s] >= 0) {
+            pixelParaSuperno[i] = info.idNovo[s];
+            continue;
+        }
+        int r = uf.find(elemento(i));
+        if (idComponente[r] < 0) {
+            idComponente[r] = numSupernos++;
+            sumR.push_back(0); sumG.push_back(0); sumB.push_back(0);
+            contagens.push_back(0);
+        }
+        int id = idComponente[r], j = id - info.supernosMantidos;
+        pixelParaSuperno[i] = id;
+        sumR[j] += dadosImagem[i * 3]; sumG[j] += dadosImagem[i * 3 + 1]; sumB[j] += dadosImagem[i * 3 + 2];
+        contagens[id]++;
+        pixelsNovos.push_back(i);
+    }
+    for (int id = info.supernosMantidos; id < numSupernos; ++id) {
+        int j = id - info.supernosMantidos;
+        cores.emplace_back(sumR[j] / contagens[id], sumG[j] / contagens[id], sumB[j] / contagens[id]);
+    }
+    coresSupernos.swap(cores);
+    countPixel.swap(contagens);
+    rastroAgrupamento.encerrar();
+
+    // Arestas entre mantidos vêm do quadro anterior (ids em ordem crescente,
+    // então origem < destino continua valendo); as que tocam um superpixel
+    // novo saem dos pixels novos
+    EscopoRastro rastroArestas("incremental:arestas");
+    std::vector<Aresta> arestas;
+    arestas.reserve(csrDestino.size());
+    for (int a = 0; a < numSupernosAnterior; ++a) {
+        if (info.idNovo[a] < 0) continue;
+        for (uint32_t k = csrInicio[a]; k < csrInicio[a + 1]; ++k) {
+            int b = info.idNovo[csrDestino[k]];
+            if (b >= 0) arestas.emplace_back(info.idNovo[a], b, csrPeso[k]);
+        }
+    }
+    std::vector<std::pair<int, int>> pares;
+    for (int p : pixelsNovos) {
+        int x = p % largura, y = p / largura, u = pixelParaSuperno[p];
+        int vizinhos[4] = {x + 1 < largura ? p + 1 : -1, y + 1 < altura ? p + largura : -1,
+                           x > 0 ? p - 1 : -1, y > 0 ? p - largura : -1};
+        for (int q : vizinhos) {
+            if (q >= 0 && pixelParaSuperno[q] != u) pares.push_back(std::minmax(u, pixelParaSuperno[q]));
+        }
+    }
+    std::sort(pares.begin(), pares.end());
+    pares.erase(std::unique(pares.begin(), pares.end()), pares.end());
+    for (const auto& par : pares) {
+        double peso = calcularDiferencaCorMedia(coresSupernos[par.first], coresSupernos[par.second]);
+        arestas.emplace_back(par.first, par.second, peso / MAX_PESO);
+    }
+    montarCSR(numSupernos, arestas);
+    rastroArestas.encerrar();
+
+    // A referência dos pixels reagrupados passa a ser o quadro atual
+    for (int p : pixelsSujos) std::memcpy(&quadroReferencia[(size_t)p * 3], &dadosImagem[(size_t)p * 3], 3);
+
+    if (verboso) {
+        std::cout << "Grafo incremental: " << info.ladrilhosAlterados << "/" << info.ladrilhosTotal << " ladrilhos alterados, "
+                  << info.supernosMantidos << " supernos mantidos, " << numSupernos << " no total.\n";
+    }
+    return grafoDoCSR(numSupernos, csrInicio.data(), csrDestino.data(), csrPeso.data());
 }
 
+uint64_t SegmentadorImagem::chaveCache() const {
+    uint64_t hash = fnv1a(&VERSAO_CACHE_GRAFO, sizeof(VERSAO_CACHE_GRAFO));
+    hash = fnv1a(&LIMIAR_AGRUPAMENTO, sizeof(LIMIAR_AGRUPAMENTO), hash);
+    hash = fnv1a(&MAX_PESO, sizeof(MAX_PESO), hash);
+    hash = fnv1a(&largura, sizeof(largura), hash);
+    hash = fnv1a(&altura, sizeof(altura), hash);
+    hash = fnv1a(&ordem, sizeof(ordem), hash);
+    hash = fnv1a(&superpixelsAlvo, sizeof(superpixelsAlvo), hash);
+    if (superpixelsAlvo > 0) {
+        hash = fnv1a(&ITERACOES_SLIC, sizeof(ITERACOES_SLIC), hash);
+        hash = fnv1a(&COMPACIDADE_SLIC, sizeof(COMPACIDADE_SLIC), hash);
+    }
+    return fnv1a(dadosImagem, (size_t)largura * altura * 3, hash);
+}
+
+bool SegmentadorImagem::carregarCache(const std::string& caminho, uint64_t chave, GrafoNaoDirecionadoPonderado& grafo) {
+    FILE* teste = fopen(caminho.c_str(), "rb");
+    if (!teste) return false; // Ausente: caso comum, sem exceção
+    fclose(teste);
+
+    try {
+        ArquivoMapeado arquivo(caminho);
+        const CabecalhoCacheGrafo* cab = (const CabecalhoCacheGrafo*)arquivo.dados();
+        if (arquivo.tamanho() < sizeof(CabecalhoCacheGrafo)
+            || std::memcmp(cab->magica, "SGCG", 4) != 0 || cab->versao != VERSAO_CACHE_GRAFO || cab->chave != chave
+            || (int)cab->largura != largura || (int)cab->altura != altura) {
+            return false;
+        }
+
+        const size_t numPixels = (size_t)largura * altura;
+        const size_t ns = cab->numSupernos, m = cab->numArestas;
+        size_t esperado = sizeof(CabecalhoCacheGrafo) + m * sizeof(double) + (ns + 1 + m) * sizeof(uint32_t)
+                        + numPixels * sizeof(int32_t) + ns * sizeof(uint32_t) + ns * 3;
+        if (arquivo.tamanho() != esperado) return false;
+
+        const char* p = arquivo.dados() + sizeof(CabecalhoCacheGrafo);
+        const double* peso = (const double*)p;                 p += m * sizeof(double);
+        const uint32_t* inicio = (const uint32_t*)p;           p += (ns + 1) * sizeof(uint32_t);
+        const uint32_t* destino = (const uint32_t*)p;          p += m * sizeof(uint32_t);
+        const int32_t* supernoPixel = (const int32_t*)p;       p += numPixels * sizeof(int32_t);
+        const uint32_t* pixelsSuperno = (const uint32_t*)p;    p += ns * sizeof(uint32_t);
+        const unsigned char* cores = (const unsigned char*)p;
 
-void SegmentadorImagem::salvarSegmentacao(const GrafoDirecionadoPonderado& arborescencia, const std::string& saida, double limiarCorte) {
+        // Um arquivo truncado ou adulterado com o tamanho certo ainda passa pelas
+        // verificações acima; valida o conteúdo antes de indexar com ele.
+        if (ns > (size_t)INT32_MAX || inicio[0] != 0 || inicio[ns] != m) return false;
+        for (size_t v = 0; v < ns; ++v) {
+            if (inicio[v] > inicio[v + 1]) return false;
+        }
+        for (size_t k = 0; k < m; ++k) {
+            if (destino[k] >= ns) return false;
+        }
+        for (size_t i = 0; i < numPixels; ++i) {
+            if (supernoPixel[i] < 0 || (size_t)supernoPixel[i] >= ns) return false;
+        }
+
+        pixelParaSuperno.assign(supernoPixel, supernoPixel + numPixels);
+        countPixel.assign(pixelsSuperno, pixelsSuperno + ns);
+        coresSupernos.resize(ns);
+        for (size_t i = 0; i < ns; ++i) coresSupernos[i] = {cores[3 * i], cores[3 * i + 1], cores[3 * i + 2]};
+
+        // O grafo e as atualizações incrementais trabalham sobre cópias em
+        // memória; o mapeamento só evita uma leitura intermediária do arquivo
+        csrInicio.assign(inicio, inicio + ns + 1);
+        csrDestino.assign(destino, destino + m);
+        csrPeso.assign(peso, peso + m);
+        grafo = grafoDoCSR((int)ns, csrInicio.data(), csrDestino.data(), csrPeso.data());
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool SegmentadorImagem::salvarCache(const std::string& caminho, uint64_t chave) const {
+    const size_t numPixels = (size_t)largura * altura;
+    const size_t ns = coresSupernos.size(), m = csrDestino.size();
+
+    CabecalhoCacheGrafo cab = {};
+    std::memcpy(cab.magica, "SGCG", 4);
+    cab.versao = VERSAO_CACHE_GRAFO;
+    cab.chave = chave;
+    cab.largura = (uint32_t)largura;
+    cab.altura = (uint32_t)altura;
+    cab.numSupernos = (uint32_t)ns;
+    cab.numArestas = (uint32_t)m;
+
+    std::vector<unsigned char> cores(ns * 3);
+    for (size_t i = 0; i < ns; ++i) {
+        auto [r, g, b] = coresSupernos[i];
+        cores[3 * i] = (unsigned char)r;
+        cores[3 * i + 1] = (unsigned char)g;
+        cores[3 * i + 2] = (unsigned char)b;
+    }
+
+    // Grava num temporário e renomeia: leitores (outras threads ou processos)
+    // nunca veem um arquivo pela metade
+    std::string temporario = caminho + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    FILE* f = fopen(temporario.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(&cab, sizeof(cab), 1, f) == 1
+        && fwrite(csrPeso.data(), sizeof(double), m, f) == m
+        && fwrite(csrInicio.data(), sizeof(uint32_t), ns + 1, f) == ns + 1
+        && fwrite(csrDestino.data(), sizeof(uint32_t), m, f) == m
+        && fwrite(pixelParaSuperno.data(), sizeof(int32_t), numPixels, f) == numPixels
+        && fwrite(countPixel.data(), sizeof(uint32_t), ns, f) == ns
+        && fwrite(cores.data(), 1, cores.size(), f) == cores.size();
+    ok = fclose(f) == 0 && ok;
+    if (!ok || std::rename(temporario.c_str(), caminho.c_str()) != 0) {
+        std::remove(temporario.c_str());
+        return false;
+    }
+    return true;
+}
+
+int SegmentadorImagem::maiorSuperpixel() const {
+    int maior = 0;
+    if (ordem == OrdemSupernos::VARREDURA) {
+        for (int i = 1; i < (int)coresSupernos.size(); ++i) {
+            if (countPixel[i] > countPixel[maior]) maior = i;
+        }
+        return maior;
+    }
+
+    // Renumerados: percorre os pixels para desempatar pela ordem de varredura
+    maior = pixelParaSuperno.empty() ? 0 : pixelParaSuperno[0];
+    for (int s : pixelParaSuperno) {
+        if (countPixel[s] > countPixel[maior]) maior = s;
+    }
+    return maior;
+}
+
+int SegmentadorImagem::supernoRaiz(int raiz) const {
+    if (raiz < 0) return maiorSuperpixel();
+    if (ordem == OrdemSupernos::VARREDURA) return raiz;
+
+    // k-ésimo superpixel a aparecer na varredura; fora do intervalo, o índice
+    // segue como veio e o solver acusa a raiz inválida
+    std::vector<char> visto(coresSupernos.size(), 0);
+    int encontrados = 0;
+    for (int s : pixelParaSuperno) {
+        if (visto[s]) continue;
+        visto[s] = 1;
+        if (encontrados++ == raiz) return s;
+    }
+    return raiz;
+}
+
+// Reordena os ids pelo índice do centróide na curva escolhida e aplica a
+// permutação a pixelParaSuperno, às cores e às contagens de pixels
+void SegmentadorImagem::renumerarSupernos(int numSupernos) {
+    const int numPixels = largura * altura;
+    sumX.assign(numSupernos, 0);
+    sumY.assign(numSupernos, 0);
+    for (int i = 0; i < numPixels; ++i) {
+        int s = pixelParaSuperno[i];
+        sumX[s] += i % largura;
+        sumY[s] += i / largura;
+    }
+
+    uint32_t lado = 1;
+    while (lado < (uint32_t)std::max(largura, altura)) lado *= 2;
+
+    chaveCurva.resize(numSupernos);
+    for (int s = 0; s < numSupernos; ++s) {
+        uint32_t cx = (uint32_t)(sumX[s] / countPixel[s]);
+        uint32_t cy = (uint32_t)(sumY[s] / countPixel[s]);
+        chaveCurva[s] = ordem == OrdemSupernos::HILBERT ? indiceHilbert(lado, cx, cy) : indiceMorton(cx, cy);
+    }
+
+    // Ordem por (chave, id antigo): determinística mesmo com centróides iguais
+    porChave.resize(numSupernos);
+    for (int s = 0; s < numSupernos; ++s) porChave[s] = s;
+    std::sort(porChave.begin(), porChave.end(), [&](int a, int b) {
+        return chaveCurva[a] != chaveCurva[b] ? chaveCurva[a] < chaveCurva[b] : a < b;
+    });
+    novoId.resize(numSupernos);
+    for (int k = 0; k < numSupernos; ++k) novoId[porChave[k]] = k;
+
+    for (int i = 0; i < numPixels; ++i) pixelParaSuperno[i] = novoId[pixelParaSuperno[i]];
+
+    std::vector<std::tuple<int, int, int>> cores(numSupernos);
+    std::vector<int> contagens(numSupernos);
+    for (int k = 0; k < numSupernos; ++k) {
+        cores[k] = coresSupernos[porChave[k]];
+        contagens[k] = countPixel[porChave[k]];
+    }
+    coresSupernos.swap(cores);
+    // countPixel tem numPixels posições; só as numSupernos primeiras valem
+    std::copy(contagens.begin(), contagens.end(), countPixel.begin());
+}
+
+
+// SLIC: k-means em (r, g, b, x, y) a partir de uma grade de centros com passo
+// S = sqrt(pixels / alvo). Cada pixel compara só os centros das 3x3 células da
+// grade em torno da sua, então faixas de linhas são independentes e rodam em
+// paralelo, cada uma com seus acumuladores. Ao final, os pixels de mesmo rótulo
+// e 4-conexos viram um conjunto em 'uf', e fragmentos menores que S²/4 são
+// absorvidos por um vizinho: o número de superpixels fica perto do alvo.
+void SegmentadorImagem::agruparSLIC(UnionFind& uf) {
+    const int numPixels = largura * altura;
+    const int alvo = std::min(superpixelsAlvo, numPixels);
+    const double passo = std::sqrt((double)numPixels / alvo);
+    const int gradeX = std::max(1, (int)std::lround(largura / passo));
+    const int gradeY = std::max(1, (int)std::lround(altura / passo));
+    const double passoX = (double)largura / gradeX, passoY = (double)altura / gradeY;
+    const double pesoEspacial = (COMPACIDADE_SLIC / passo) * (COMPACIDADE_SLIC / passo);
+    const int numCentros = gradeX * gradeY;
+
+    // Centro c (célula c da grade): r, g, b, x, y
+    centrosSLIC.resize(numCentros * 5);
+    for (int gy = 0; gy < gradeY; ++gy) {
+        for (int gx = 0; gx < gradeX; ++gx) {
+            double* c = &centrosSLIC[(gy * gradeX + gx) * 5];
+            int x = std::min(largura - 1, (int)((gx + 0.5) * passoX));
+            int y = std::min(altura - 1, (int)((gy + 0.5) * passoY));
+            const unsigned char* px = &dadosImagem[getIndice(x, y) * 3];
+            c[0] = px[0]; c[1] = px[1]; c[2] = px[2]; c[3] = x; c[4] = y;
+        }
+    }
+
+    int threads = threadsSLIC > 0 ? threadsSLIC : (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, altura);
+    rotuloSLIC.resize(numPixels);
+
+    // Acumuladores por faixa: soma de r, g, b, x, y e número de pixels
+    acumuladoresSLIC.resize((size_t)threads * numCentros * 6);
+
+    auto atribuirFaixa = [&](int faixa) {
+        double* acc = &acumuladoresSLIC[(size_t)faixa * numCentros * 6];
+        std::fill(acc, acc + (size_t)numCentros * 6, 0.0);
+        int y0 = (int)((long long)altura * faixa / threads), y1 = (int)((long long)altura * (faixa + 1) / threads);
+        for (int y = y0; y < y1; ++y) {
+            int cy = std::min(gradeY - 1, (int)(y / passoY));
+            for (int cx = 0; cx < gradeX; ++cx) {
+                // Candidatos da célula (cx, cy), copiados uma vez para o trecho da linha
+                int candidatos[9], numCandidatos = 0;
+                for (int vy = std::max(0, cy - 1); vy <= std::min(gradeY - 1, cy + 1); ++vy)
+                    for (int vx = std::max(0, cx - 1); vx <= std::min(gradeX - 1, cx + 1); ++vx)
+                        candidatos[numCandidatos++] = vy * gradeX + vx;
+
+                int x0 = (int)std::ceil(cx * passoX);
+                int x1 = cx + 1 == gradeX ? largura : (int)std::ceil((cx + 1) * passoX);
+                for (int x = x0; x < x1; ++x) {
+                    int i = getIndice(x, y);
+                    const unsigned char* px = &dadosImagem[i * 3];
+
+                    int melhor = candidatos[0];
+                    double menor = -1.0;
+                    for (int j = 0; j < numCandidatos; ++j) {
+                        const double* c = &centrosSLIC[candidatos[j] * 5];
+                        double dr = px[0] - c[0], dg = px[1] - c[1], db = px[2] - c[2];
+                        double dx = x - c[3], dy = y - c[4];
+                        double d = dr * dr + dg * dg + db * db + pesoEspacial * (dx * dx + dy * dy);
+                        if (menor < 0 || d < menor) { menor = d; melhor = candidatos[j]; }
+                    }
+
+                    rotuloSLIC[i] = melhor;
+                    double* a = &acc[melhor * 6];
+                    a[0] += px[0]; a[1] += px[1]; a[2] += px[2]; a[3] += x; a[4] += y; a[5] += 1;
+                }
+            }
+        }
+    };
+
+    std::unique_ptr<PoolThreads> pool;
+    if (threads > 1) pool.reset(new PoolThreads(threads));
+
+    for (int it = 0; it < ITERACOES_SLIC; ++it) {
+        if (pool) {
+            for (int f = 0; f < threads; ++f) pool->enfileirar([&, f](int) { atribuirFaixa(f); });
+            pool->aguardar();
+        } else {
+            atribuirFaixa(0);
+        }
+
+        // Centros vão para a média dos seus pixels (centro sem pixels fica onde está)
+        for (int k = 0; k < numCentros; ++k) {
+            double soma[6] = {0, 0, 0, 0, 0, 0};
+            for (int f = 0; f < threads; ++f) {
+                const double* a = &acumuladoresSLIC[((size_t)f * numCentros + k) * 6];
+                for (int j = 0; j < 6; ++j) soma[j] += a[j];
+            }
+            if (soma[5] == 0) continue;
+            for (int j = 0; j < 5; ++j) centrosSLIC[k * 5 + j] = soma[j] / soma[5];
+        }
+    }
+
+    // Componentes 4-conexos de cada rótulo
+    for (int y = 0; y < altura; ++y) {
+        for (int x = 0; x < largura; ++x) {
+            int u = getIndice(x, y);
+            if (x + 1 < largura && rotuloSLIC[u + 1] == rotuloSLIC[u]) uf.unite(u, u + 1);
+            if (y + 1 < altura && rotuloSLIC[u + largura] == rotuloSLIC[u]) uf.unite(u, u + largura);
+        }
+    }
+
+    // Fragmentos pequenos se juntam ao primeiro componente vizinho encontrado
+    tamanhoSLIC.assign(numPixels, 0);
+    for (int i = 0; i < numPixels; ++i) tamanhoSLIC[uf.find(i)]++;
+    const int minimo = std::max(1, (int)(passo * passo / 4));
+    for (int y = 0; y < altura; ++y) {
+        for (int x = 0; x < largura; ++x) {
+            int u = getIndice(x, y);
+            int r = uf.find(u);
+            if (tamanhoSLIC[r] >= minimo) continue;
+            int vizinhos[4] = {x > 0 ? u - 1 : -1, y > 0 ? u - largura : -1,
+                               x + 1 < largura ? u + 1 : -1, y + 1 < altura ? u + largura : -1};
+            for (int v : vizinhos) {
+                if (v < 0) continue;
+                int rv = uf.find(v);
+                if (rv == r) continue;
+                int total = tamanhoSLIC[r] + tamanhoSLIC[rv];
+                uf.unite(r, rv);
+                tamanhoSLIC[uf.find(r)] = total;
+                break;
+            }
+        }
+    }
+}
+
+int SegmentadorImagem::rotularRegioes(const GrafoDirecionadoPonderado& arborescencia, double limiarCorte, std::vector<uint32_t>& rotulosPixel) {
     // O grafo agora representa supernos
     int numSupernos = arborescencia.numVertices();
     
@@ -194,15 +898,12 @@ void SegmentadorImagem::salvarSegmentacao(const GrafoDirecionadoPonderado& arbor
 
     std::vector<int> compSuperno(numSupernos, -1);
     int numComponentes = 0;
-    std::vector<std::tuple<unsigned char, unsigned char, unsigned char>> coresComponentes;
 
     // Busca em largura (BFS) para identificar regiões
     for (int i = 0; i < numSupernos; ++i) {
         if (compSuperno[i] == -1) {
             numComponentes++;
             
-            coresComponentes.emplace_back(rand() % 255, rand() % 255, rand() % 255);
-            
             std::queue<int> q;
             q.push(i);
             compSuperno[i] = numComponentes - 1;
@@ -219,23 +920,116 @@ void SegmentadorImagem::salvarSegmentacao(const GrafoDirecionadoPonderado& arbor
         }
     }
 
-    std::cout << "Segmentacao final: " << numComponentes << " regioes.\n";
-
-    // Mapeia cada pixel para a cor do seu componente correspondente
-    std::vector<unsigned char> imagemSaida(largura * altura * 3);
-    
+    // Mapeia cada pixel para o componente do seu superno
+    rotulosPixel.resize(largura * altura);
     for(int i=0; i < largura * altura; ++i) {
         int superNoId = pixelParaSuperno[i];
-        if (superNoId == -1) continue; 
-        
-        int componenteId = compSuperno[superNoId];
-        if (componenteId == -1) componenteId = 0;
+        int componenteId = (superNoId == -1) ? -1 : compSuperno[superNoId];
+        rotulosPixel[i] = (componenteId == -1) ? 0 : componenteId;
+    }
 
-        auto [r, g, b] = coresComponentes[componenteId];
-        imagemSaida[i * 3 + 0] = r;
-        imagemSaida[i * 3 + 1] = g;
-        imagemSaida[i * 3 + 2] = b;
+    if (niveisPiramide > 0) refinarPiramide(rotulosPixel, numComponentes);
+
+    return numComponentes;
+}
+
+// Leva os rótulos da escala reduzida para a original: cada pixel herda o
+// rótulo do seu bloco e, nos blocos vizinhos a outra região (3x3 na escala
+// reduzida), vai para a região adjacente de cor média mais próxima da sua
+void SegmentadorImagem::refinarPiramide(std::vector<uint32_t>& rotulosPixel, int numRegioes) {
+    EscopoRastro rastro("refinarPiramide");
+    const int f = 1 << niveisPiramide;
+    rotulosGrossos.swap(rotulosPixel);
+    rotulosPixel.resize((size_t)larguraCheia * alturaCheia);
+
+    // Cor média de cada região na resolução original: r, g, b, pixels
+    somaRegiao.assign((size_t)numRegioes * 4, 0);
+    for (int y = 0; y < alturaCheia; ++y) {
+        const uint32_t* linhaGrossa = &rotulosGrossos[(size_t)(y >> niveisPiramide) * largura];
+        uint32_t* linha = &rotulosPixel[(size_t)y * larguraCheia];
+        const unsigned char* px = &imagemCheia[(size_t)y * larguraCheia * 3];
+        for (int x = 0; x < larguraCheia; ++x, px += 3) {
+            uint32_t r = linhaGrossa[x >> niveisPiramide];
+            linha[x] = r;
+            long long* m = &somaRegiao[r * 4];
+            m[0] += px[0]; m[1] += px[1]; m[2] += px[2]; m[3] += 1;
+        }
+    }
+    mediaRegiao.resize((size_t)numRegioes * 3);
+    for (int r = 0; r < numRegioes; ++r) {
+        for (int c = 0; c < 3; ++c) mediaRegiao[r * 3 + c] = (double)somaRegiao[r * 4 + c] / somaRegiao[r * 4 + 3];
+    }
+
+    for (int by = 0; by < altura; ++by) {
+        for (int bx = 0; bx < largura; ++bx) {
+            uint32_t candidatos[9];
+            int numCandidatos = 0;
+            for (int vy = std::max(0, by - 1); vy <= std::min(altura - 1, by + 1); ++vy) {
+                for (int vx = std::max(0, bx - 1); vx <= std::min(largura - 1, bx + 1); ++vx) {
+                    uint32_t r = rotulosGrossos[getIndice(vx, vy)];
+                    if (std::find(candidatos, candidatos + numCandidatos, r) == candidatos + numCandidatos)
+                        candidatos[numCandidatos++] = r;
+                }
+            }
+            if (numCandidatos == 1) continue; // Interior de uma região
+
+            int y1 = std::min(alturaCheia, (by + 1) * f), x1 = std::min(larguraCheia, (bx + 1) * f);
+            for (int y = by * f; y < y1; ++y) {
+                for (int x = bx * f; x < x1; ++x) {
+                    size_t i = (size_t)y * larguraCheia + x;
+                    const unsigned char* px = &imagemCheia[i * 3];
+                    double menor = -1.0;
+                    for (int j = 0; j < numCandidatos; ++j) {
+                        const double* m = &mediaRegiao[candidatos[j] * 3];
+                        double dr = px[0] - m[0], dg = px[1] - m[1], db = px[2] - m[2];
+                        double d = dr * dr + dg * dg + db * db;
+                        if (menor < 0 || d < menor) { menor = d; rotulosPixel[i] = candidatos[j]; }
+                    }
+                }
+            }
+        }
     }
+}
+
+bool SegmentadorImagem::salvarSegmentacao(const GrafoDirecionadoPonderado& arborescencia, const std::string& saida, double limiarCorte,
+                                          const OpcoesSaida& opcoes) {
+    EscopoRastro rastro("salvarSegmentacao", saida.c_str());
+    std::vector<uint32_t> rotulos;
+    EscopoRastro rastroRotulos("rotularRegioes");
+    int numComponentes = rotularRegioes(arborescencia, limiarCorte, rotulos);
+    rastroRotulos.encerrar();
 
-    stbi_write_png(saida.c_str(), largura, altura, 3, imagemSaida.data(), largura * 3);
-}
\ No newline at end of file
+    if (verboso) std::cout << "Segmentacao final: " << numComponentes << " regioes.\n";
+
+    bool ok;
+    if (opcoes.formato == FormatoSaida::ROTULOS) {
+        // Mapa de rotulos: nenhuma colorizacao necessaria
+        ok = EscritorSaida::escreverRotulos(saida, larguraCheia, alturaCheia, rotulos, numComponentes);
+    } else {
+        // Gerador por thread: rand() nao e seguro com varias imagens em paralelo
+        static thread_local std::mt19937 gerador(std::random_device{}());
+        std::uniform_int_distribution<int> distCor(0, 254);
+
+        std::vector<std::tuple<unsigned char, unsigned char, unsigned char>> coresComponentes;
+        coresComponentes.reserve(numComponentes);
+        for (int c = 0; c < numComponentes; ++c) {
+            coresComponentes.emplace_back(distCor(gerador), distCor(gerador), distCor(gerador));
+        }
+
+        // Mapeia cada pixel para a cor do seu componente correspondente
+        std::vector<unsigned char> imagemSaida((size_t)larguraCheia * alturaCheia * 3);
+        for(int i=0; i < larguraCheia * alturaCheia; ++i) {
+            auto [r, g, b] = coresComponentes[rotulos[i]];
+            imagemSaida[i * 3 + 0] = r;
+            imagemSaida[i * 3 + 1] = g;
+            imagemSaida[i * 3 + 2] = b;
+        }
+
+        if (opcoes.formato == FormatoSaida::PPM)
+            ok = EscritorSaida::escreverPPM(saida, larguraCheia, alturaCheia, imagemSaida.data());
+        else
+            ok = EscritorSaida::escreverPNG(saida, larguraCheia, alturaCheia, imagemSaida.data(), opcoes.nivelCompressaoPng);
+    }
+
+    return ok;
+}
@@ -0,0 +1,149 @@
+#include "SeletorMetodo.h"
+#include "AlgoritmoEdmonds.h"
+#include "AlgoritmoKruskal.h"
+#include "AlgoritmoTarjan.h"
+#include "AlgoritmoGabow.h"
+#include "ArvoreContracao.h"
+#include "Rastreamento.h"
+#include <stdexcept>
+
+bool SeletorMetodo::valido(int metodo) {
+    return metodo >= 0 && metodo <= 4;
+}
+
+const char* SeletorMetodo::nome(int metodo) {
+    switch (metodo) {
+        case 0: return "edmonds";
+        case 1: return "kruskal";
+        case 2: return "tarjan";
+        case 3: return "gabow";
+        case 4: return "contracao";
+        default: return "desconhecido";
+    }
+}
+
+const char* SeletorMetodo::descricao(int metodo) {
+    switch (metodo) {
+        case 0: return "Edmonds (Direcionado)";
+        case 1: return "Kruskal (Nao-Direcionado)";
+        case 2: return "Tarjan (Otimizado c/ Skew Heaps)";
+        case 3: return "Gabow Modificado (c/ Skew Heaps)";
+        case 4: return "Arvore de Contracao (qualquer raiz)";
+        default: return "Desconhecido";
+    }
+}
+
+// Arestas não direcionadas vistas pelo Kruskal: as guardadas, se o grafo já
+// é simétrico; senão uma por par u < v
+static std::vector<Aresta> arestasNaoDirecionadas(const GrafoDirecionadoPonderado& grafo) {
+    if (grafo.ehSimetrico()) return grafo.getTodasArestas();
+
+    size_t total = 0;
+    for (const auto& a : grafo.getTodasArestas()) total += a.origem < a.destino;
+
+    std::vector<Aresta> arestas;
+    arestas.reserve(total);
+    for (const auto& a : grafo.getTodasArestas()) {
+        if (a.origem < a.destino)
+            arestas.emplace_back(a.origem, a.destino, a.peso);
+    }
+    return arestas;
+}
+
+// Instancia o algoritmo com a política de heap escolhida em tempo de execução.
+// O despacho acontece uma vez por chamada; dentro do algoritmo não há funções virtuais.
+template <class Algoritmo>
+static GrafoDirecionadoPonderado resolverComHeap(GrafoDirecionadoPonderado& grafo, int raiz,
+                                                 EspacoTrabalhoArborescencia* espaco, PoliticaHeap heap,
+                                                 EstatisticasSolver* estatisticas) {
+    EspacoTrabalhoArborescencia local;
+    EspacoTrabalhoArborescencia& e = espaco ? *espaco : local;
+    Algoritmo algoritmo;
+    switch (heap) {
+        case PoliticaHeap::LEFTIST: return algoritmo.template encontrarArborescenciaMinima<HeapLeftist>(grafo, raiz, e, estatisticas);
+        case PoliticaHeap::PAIRING: return algoritmo.template encontrarArborescenciaMinima<HeapPairing>(grafo, raiz, e, estatisticas);
+        case PoliticaHeap::RADIX: return algoritmo.template encontrarArborescenciaMinima<HeapRadix>(grafo, raiz, e, estatisticas);
+        default: return algoritmo.template encontrarArborescenciaMinima<HeapSkew>(grafo, raiz, e, estatisticas);
+    }
+}
+
+// Constrói a árvore de contração completa e extrai a arborescência da raiz pedida
+static GrafoDirecionadoPonderado resolverPorContracao(GrafoDirecionadoPonderado& grafo, int raiz, PoliticaHeap heap) {
+    ArvoreContracao arvore;
+    switch (heap) {
+        case PoliticaHeap::LEFTIST: arvore.construir<HeapLeftist>(grafo); break;
+        case PoliticaHeap::PAIRING: arvore.construir<HeapPairing>(grafo); break;
+        case PoliticaHeap::RADIX: arvore.construir<HeapRadix>(grafo); break;
+        default: arvore.construir<HeapSkew>(grafo); break;
+    }
+
+    const VisaoArcos arcos = grafo.getArcos();
+    const std::vector<int>& escolhidas = arvore.extrair(raiz);
+    EscopoRastro rastro("contracao:montagem");
+    std::vector<Aresta> arestas;
+    arestas.reserve(escolhidas.size());
+    for (int edgeID : escolhidas) {
+        const auto& aresta = arcos[edgeID];
+        arestas.emplace_back(aresta.origem, aresta.destino, aresta.peso);
+    }
+    return GrafoDirecionadoPonderado(grafo.numVertices(), std::move(arestas));
+}
+
+GrafoDirecionadoPonderado SeletorMetodo::resolver(int metodo, GrafoDirecionadoPonderado& grafo, int raiz,
+                                                  EspacoTrabalhoArborescencia* espaco, PoliticaHeap heap,
+                                                  EstatisticasSolver* estatisticas) {
+    if (metodo != 1 && (raiz < 0 || raiz >= grafo.numVertices())) {
+        throw std::runtime_error("Raiz fora do intervalo de vertices.");
+    }
+    if (estatisticas) *estatisticas = EstatisticasSolver();
+    EscopoRastro rastro("resolver", nome(metodo));
+
+    switch (metodo) {
+        case 0: {
+            AlgoritmoEdmonds edmonds;
+            return edmonds.encontrarArborescenciaMinima(grafo, raiz, estatisticas);
+        }
+        case 1: {
+            EscopoRastro rastroConversao("kruskal:arestas");
+            GrafoNaoDirecionadoPonderado grafoNaoDir(grafo.numVertices(), arestasNaoDirecionadas(grafo));
+            rastroConversao.encerrar();
+            AlgoritmoKruskal kruskal;
+            // Fatiamento intencional: a segmentação só usa as arestas da base
+            return kruskal.encontrarMST(grafoNaoDir);
+        }
+        case 2:
+            return resolverComHeap<AlgoritmoTarjan>(grafo, raiz, espaco, heap, estatisticas);
+        case 3:
+            return resolverComHeap<AlgoritmoGabow>(grafo, raiz, espaco, heap, estatisticas);
+        case 4:
+            return resolverPorContracao(grafo, raiz, heap);
+        default:
+            throw std::runtime_error("Metodo invalido. Escolha um metodo de 0 a 4.");
+    }
+}
+
+bool SeletorMetodo::verificavel(int metodo) {
+    return metodo >= 1 && metodo <= 3;
+}
+
+void SeletorMetodo::exigirVerificavel(int metodo) {
+    if (!verificavel(metodo)) {
+        throw std::runtime_error(std::string("--verificar nao vale para o metodo ") + std::to_string(metodo) + " ("
+                                 + nome(metodo) + "), que nao deixa certificado dual. Use os metodos 1 a 3.");
+    }
+}
+
+ResultadoVerificacao SeletorMetodo::verificar(int metodo, GrafoDirecionadoPonderado& grafo, int raiz,
+                                              const GrafoDirecionadoPonderado& resultado,
+                                              EspacoTrabalhoArborescencia* espaco) {
+    EscopoRastro rastro("verificar", nome(metodo));
+    if (metodo == 1) {
+        return VerificadorOtimalidade::verificarMST(grafo.numVertices(), arestasNaoDirecionadas(grafo),
+                                                    resultado.getTodasArestas());
+    }
+
+    exigirVerificavel(metodo);
+    if (!espaco) throw std::runtime_error("Verificacao sem o espaco de trabalho da resolucao (certificado dual).");
+    return VerificadorOtimalidade::verificarArborescencia(grafo, raiz, resultado.getTodasArestas(),
+                                                          VerificadorOtimalidade::certificado(*espaco));
+}
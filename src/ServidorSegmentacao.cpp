@@ -0,0 +1,329 @@
+#include "ServidorSegmentacao.h"
+#include "SegmentadorImagem.h"
+#include "SeletorMetodo.h"
+#include "EspacoTrabalhoArborescencia.h"
+#include "PoolThreads.h"
+#include "Rastreamento.h"
+#include <iostream>
+#include <sstream>
+#include <filesystem>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static std::vector<std::string> separar(const std::string& texto, char separador) {
+    std::vector<std::string> partes;
+    std::string parte;
+    std::istringstream in(texto);
+    while (std::getline(in, parte, separador)) partes.push_back(parte);
+    return partes;
+}
+
+RequisicaoSegmentacao RequisicaoSegmentacao::interpretar(const std::string& linha) {
+    RequisicaoSegmentacao r;
+    bool temMetodo = false;
+    for (const std::string& campo : separar(linha, '\t')) {
+        if (campo.empty()) continue;
+        size_t igual = campo.find('=');
+        if (igual == std::string::npos) throw std::runtime_error("campo sem valor: " + campo);
+        std::string chave = campo.substr(0, igual), valor = campo.substr(igual + 1);
+
+        try {
+            if (chave == "imagem") r.imagem = valor;
+            else if (chave == "saida") r.saida = valor;
+            else if (chave == "metodo") { r.metodo = std::stoi(valor); temMetodo = true; }
+            else if (chave == "limiar") {
+                for (const std::string& l : separar(valor, ',')) r.limiares.push_back(std::stod(l));
+            } else if (chave == "formato") {
+                if (!EscritorSaida::formatoPorNome(valor, r.opcoesSaida.formato)) throw std::invalid_argument(valor);
+            } else if (chave == "compressao") {
+                r.opcoesSaida.nivelCompressaoPng = std::stoi(valor);
+                if (r.opcoesSaida.nivelCompressaoPng < 0 || r.opcoesSaida.nivelCompressaoPng > 9) throw std::invalid_argument(valor);
+            } else if (chave == "raiz") {
+                r.raiz = valor == "maior" ? -1 : std::stoi(valor);
+                if (r.raiz < -1) throw std::invalid_argument(valor);
+            } else if (chave == "heap") {
+                if (!politicaHeapPorNome(valor, r.heap)) throw std::invalid_argument(valor);
+            } else if (chave == "verificar") r.verificar = valor == "1";
+            else throw std::runtime_error("campo desconhecido: " + chave);
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("valor invalido para " + chave + ": " + valor);
+        }
+    }
+
+    if (r.imagem.empty()) throw std::runtime_error("falta o campo imagem");
+    if (r.saida.empty()) throw std::runtime_error("falta o campo saida");
+    if (!temMetodo || !SeletorMetodo::valido(r.metodo)) throw std::runtime_error("metodo ausente ou invalido");
+    if (r.limiares.empty()) throw std::runtime_error("falta o campo limiar");
+    if (r.verificar) SeletorMetodo::exigirVerificavel(r.metodo);
+    return r;
+}
+
+// Caminho de saída do i-ésimo limiar: o próprio, se só há um
+static std::string saidaDoLimiar(const std::string& saida, size_t i, size_t total) {
+    if (total == 1) return saida;
+    fs::path p(saida);
+    return (p.parent_path() / (p.stem().string() + "_" + std::to_string(i) + p.extension().string())).string();
+}
+
+// Atende uma requisição com os buffers aquecidos do trabalhador
+static std::string atender(const RequisicaoSegmentacao& r, SegmentadorImagem& seg, EspacoTrabalhoArborescencia& espaco,
+                           int idTrabalhador) {
+    using namespace std::chrono;
+    EscopoRastro rastro("requisicao", r.imagem.c_str());
+    double ms[5];
+    auto inicio = steady_clock::now(), marco = inicio;
+    auto medir = [&](int fase) {
+        auto agora = steady_clock::now();
+        ms[fase] = duration<double, std::milli>(agora - marco).count();
+        marco = agora;
+    };
+
+    if (!seg.carregarImagem(r.imagem)) throw std::runtime_error("nao foi possivel carregar a imagem: " + r.imagem);
+    medir(0);
+    seg.aplicarSuavizacao();
+    medir(1);
+    GrafoNaoDirecionadoPonderado grafo = seg.criarGrafo();
+    medir(2);
+    int raiz = seg.supernoRaiz(r.raiz);
+    GrafoDirecionadoPonderado resultado = SeletorMetodo::resolver(r.metodo, grafo, raiz, &espaco, r.heap);
+    if (r.verificar) {
+        ResultadoVerificacao v = SeletorMetodo::verificar(r.metodo, grafo, raiz, resultado, &espaco);
+        if (!v.otimo) throw std::runtime_error("resultado nao e otimo: " + v.motivo);
+    }
+    medir(3);
+    for (size_t i = 0; i < r.limiares.size(); ++i) {
+        std::string saida = saidaDoLimiar(r.saida, i, r.limiares.size());
+        if (!seg.salvarSegmentacao(resultado, saida, r.limiares[i], r.opcoesSaida))
+            throw std::runtime_error("nao foi possivel gravar a saida: " + saida);
+    }
+    medir(4);
+
+    char resposta[256];
+    snprintf(resposta, sizeof(resposta),
+             "ok\tsupernos=%d\tcarregar_ms=%.2f\tsuavizar_ms=%.2f\tgrafo_ms=%.2f\tresolver_ms=%.2f\tsalvar_ms=%.2f\ttotal_ms=%.2f\ttrabalhador=%d",
+             grafo.numVertices(), ms[0], ms[1], ms[2], ms[3], ms[4],
+             duration<double, std::milli>(steady_clock::now() - inicio).count(), idTrabalhador);
+    return resposta;
+}
+
+ServidorSegmentacao::ServidorSegmentacao(const ConfigServidor& config) : config(config) {}
+
+#ifdef _WIN32
+
+int ServidorSegmentacao::executar() {
+    throw std::runtime_error("Modo servidor indisponivel no Windows (requer sockets Unix).");
+}
+
+std::vector<std::string> ServidorSegmentacao::enviar(const std::string&, const std::vector<std::string>&) {
+    throw std::runtime_error("Modo cliente indisponivel no Windows (requer sockets Unix).");
+}
+
+#else
+
+// Lê uma linha (sem o '\n') de fd, guardando o excedente em 'pendente'
+// (lado do cliente; o servidor separa as linhas no laço de leitura).
+// Retorna false no fim da conexão sem linha completa.
+static bool lerLinha(int fd, std::string& pendente, std::string& linha) {
+    for (;;) {
+        size_t fim = pendente.find('\n');
+        if (fim != std::string::npos) {
+            linha = pendente.substr(0, fim);
+            pendente.erase(0, fim + 1);
+            if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+            return true;
+        }
+        char bloco[4096];
+        ssize_t n = recv(fd, bloco, sizeof(bloco), 0);
+        if (n <= 0) return false;
+        pendente.append(bloco, (size_t)n);
+    }
+}
+
+static bool escreverLinha(int fd, const std::string& linha) {
+    std::string dados = linha + "\n";
+    size_t enviados = 0;
+    while (enviados < dados.size()) {
+        ssize_t n = send(fd, dados.data() + enviados, dados.size() - enviados, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        enviados += (size_t)n;
+    }
+    return true;
+}
+
+static sockaddr_un enderecoSocket(const std::string& caminho) {
+    sockaddr_un endereco;
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (caminho.size() >= sizeof(endereco.sun_path)) throw std::runtime_error("Caminho do socket muito longo: " + caminho);
+    std::memcpy(endereco.sun_path, caminho.c_str(), caminho.size());
+    return endereco;
+}
+
+// Conexão aberta. As requisições de uma conexão são atendidas uma de cada vez,
+// para que as respostas saiam na ordem dos pedidos; as que chegam enquanto
+// outra está no pool esperam em 'fila'. O descritor é fechado quando a leitura
+// termina e nenhuma tarefa do pool ainda o referencia.
+struct ConexaoServidor {
+    int fd;
+    std::string pendente;          // Bytes recebidos depois da última linha completa
+    std::mutex mutex;
+    std::deque<std::string> fila;
+    bool ocupada = false;          // Há uma requisição desta conexão no pool
+
+    explicit ConexaoServidor(int fd) : fd(fd) {}
+    ~ConexaoServidor() { close(fd); }
+};
+
+int ServidorSegmentacao::executar() {
+    sockaddr_un endereco = enderecoSocket(config.caminhoSocket);
+    int servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (servidor < 0) throw std::runtime_error("Nao foi possivel criar o socket.");
+    unlink(config.caminhoSocket.c_str()); // Socket de uma execução anterior
+    if (bind(servidor, (sockaddr*)&endereco, sizeof(endereco)) != 0 || listen(servidor, 64) != 0) {
+        close(servidor);
+        throw std::runtime_error("Nao foi possivel escutar em " + config.caminhoSocket + ": " + std::strerror(errno));
+    }
+    if (!config.diretorioCache.empty()) fs::create_directories(config.diretorioCache);
+
+    PoolThreads pool(config.trabalhadores);
+    std::vector<std::unique_ptr<SegmentadorImagem>> segmentadores;
+    std::vector<EspacoTrabalhoArborescencia> espacos(pool.numTrabalhadores());
+    for (int i = 0; i < pool.numTrabalhadores(); ++i) {
+        segmentadores.emplace_back(new SegmentadorImagem());
+        segmentadores.back()->setVerboso(false);
+        segmentadores.back()->setDiretorioCache(config.diretorioCache);
+    }
+
+    std::atomic<int> atendidas(0);
+    std::cout << "Servidor escutando em " << config.caminhoSocket << " com " << pool.numTrabalhadores()
+              << " trabalhadores (envie \"sair\" para encerrar)\n" << std::flush;
+
+    // Cada requisição é uma tarefa do pool; ao terminar, a tarefa despacha a
+    // próxima da mesma conexão, se houver, ou libera a conexão
+    std::function<void(std::shared_ptr<ConexaoServidor>, std::string)> despachar;
+    despachar = [&](std::shared_ptr<ConexaoServidor> conexao, std::string linha) {
+        pool.enfileirar([&, conexao, linha](int idTrabalhador) {
+            std::string resposta;
+            try {
+                resposta = atender(RequisicaoSegmentacao::interpretar(linha), *segmentadores[idTrabalhador],
+                                   espacos[idTrabalhador], idTrabalhador);
+                atendidas++;
+            } catch (const std::exception& e) {
+                resposta = std::string("erro\t") + e.what();
+            }
+            escreverLinha(conexao->fd, resposta); // Falha: o cliente já desconectou
+
+            std::lock_guard<std::mutex> trava(conexao->mutex);
+            if (conexao->fila.empty()) {
+                conexao->ocupada = false;
+                return;
+            }
+            std::string proxima = std::move(conexao->fila.front());
+            conexao->fila.pop_front();
+            despachar(conexao, std::move(proxima));
+        });
+    };
+
+    // O laço de leitura roda nesta thread e só enfileira requisições, de modo
+    // que conexões ociosas não prendem trabalhadores e "sair" é atendido mesmo
+    // com todos ocupados
+    std::map<int, std::shared_ptr<ConexaoServidor>> conexoes;
+    std::shared_ptr<ConexaoServidor> pediuSaida;
+    std::vector<pollfd> eventos;
+    while (!pediuSaida) {
+        eventos.assign(1, pollfd{servidor, POLLIN, 0});
+        for (const auto& par : conexoes) eventos.push_back(pollfd{par.first, POLLIN, 0});
+        if (poll(eventos.data(), eventos.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        if (eventos[0].revents & POLLIN) {
+            int fd = accept(servidor, nullptr, nullptr);
+            if (fd >= 0) conexoes[fd] = std::make_shared<ConexaoServidor>(fd);
+        }
+
+        for (size_t i = 1; i < eventos.size() && !pediuSaida; ++i) {
+            if (!eventos[i].revents) continue;
+            std::shared_ptr<ConexaoServidor> conexao = conexoes[eventos[i].fd];
+
+            char bloco[4096];
+            ssize_t n = recv(conexao->fd, bloco, sizeof(bloco), 0);
+            if (n <= 0) {
+                conexoes.erase(conexao->fd); // Fecha quando as tarefas pendentes terminarem
+                continue;
+            }
+            conexao->pendente.append(bloco, (size_t)n);
+
+            size_t fim;
+            while ((fim = conexao->pendente.find('\n')) != std::string::npos) {
+                std::string linha = conexao->pendente.substr(0, fim);
+                conexao->pendente.erase(0, fim + 1);
+                if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+                if (linha.empty()) continue;
+                if (linha == "sair") {
+                    pediuSaida = conexao;
+                    break;
+                }
+
+                std::lock_guard<std::mutex> trava(conexao->mutex);
+                if (conexao->ocupada) {
+                    conexao->fila.push_back(std::move(linha));
+                } else {
+                    conexao->ocupada = true;
+                    despachar(conexao, std::move(linha));
+                }
+            }
+        }
+    }
+
+    // Para de aceitar e fecha as conexões ociosas; as requisições já recebidas
+    // terminam antes da confirmação, que sai depois das respostas anteriores
+    close(servidor);
+    unlink(config.caminhoSocket.c_str());
+    conexoes.clear();
+    pool.aguardar();
+    if (pediuSaida) escreverLinha(pediuSaida->fd, "ok\tencerrando");
+    return atendidas;
+}
+
+std::vector<std::string> ServidorSegmentacao::enviar(const std::string& caminhoSocket, const std::vector<std::string>& linhas) {
+    sockaddr_un endereco = enderecoSocket(caminhoSocket);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr*)&endereco, sizeof(endereco)) != 0) {
+        if (fd >= 0) close(fd);
+        throw std::runtime_error("Nao foi possivel conectar a " + caminhoSocket + ": " + std::strerror(errno));
+    }
+
+    std::vector<std::string> respostas;
+    std::string pendente, resposta;
+    for (const std::string& linha : linhas) {
+        if (!escreverLinha(fd, linha) || !lerLinha(fd, pendente, resposta)) {
+            close(fd);
+            throw std::runtime_error("Conexao encerrada pelo servidor.");
+        }
+        respostas.push_back(resposta);
+    }
+    close(fd);
+    return respostas;
+}
+
+#endif
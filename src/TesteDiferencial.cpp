@@ -0,0 +1,169 @@
+#include "TesteDiferencial.h"
+#include "GeradorGrafos.h"
+#include "SeletorMetodo.h"
+#include "MedidorMemoria.h"
+#include "AlgoritmoTarjan.h"
+#include "AlgoritmoGabow.h"
+#include "ArvoreContracao.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+using namespace std;
+
+static double somaPesos(const GrafoDirecionadoPonderado& grafo) {
+    double soma = 0.0;
+    for (const auto& a : grafo.getTodasArestas()) soma += a.peso;
+    return soma;
+}
+
+// Alocações da segunda de duas chamadas seguidas: a primeira aquece o espaço
+// de trabalho, e no regime estável a segunda não deve alocar nada
+template <class Resolucao>
+static long long alocacoesAquecido(Resolucao resolver) {
+    resolver();
+    long long antes = MedidorMemoria::alocacoes();
+    resolver();
+    return MedidorMemoria::alocacoes() - antes;
+}
+
+// Confere Tarjan, Gabow e a árvore de contração com a heap 'Heap' (métodos 2 a
+// 5; Edmonds e Kruskal não usam espaço de trabalho). Retorna as reprovações.
+template <class Heap>
+static int conferirAlocacoes(const GrafoDirecionadoPonderado& grafo, const string& gerador, PoliticaHeap politica, ostream& log) {
+    EspacoTrabalhoArborescencia espaco;
+    AlgoritmoTarjan tarjan;
+    AlgoritmoGabow gabow;
+    ArvoreContracao arvore;
+    const char* nomes[3] = {"tarjan", "gabow", "contracao"};
+    const long long alocacoes[3] = {
+        alocacoesAquecido([&] { tarjan.encontrarArestasArborescencia<Heap>(grafo, 0, espaco); }),
+        alocacoesAquecido([&] { gabow.encontrarArestasArborescencia<Heap>(grafo, 0, espaco); }),
+        alocacoesAquecido([&] { arvore.construir<Heap>(grafo); arvore.extrair(0); }),
+    };
+
+    int falhas = 0;
+    char linha[256];
+    for (int i = 0; i < 3; ++i) {
+        if (alocacoes[i] == 0) continue;
+        snprintf(linha, sizeof(linha), "[ALOCACAO] %s V=%d %s/%s: %lld alocacoes com o espaco de trabalho aquecido\n",
+                 gerador.c_str(), grafo.numVertices(), nomes[i], nomePoliticaHeap(politica), alocacoes[i]);
+        log << linha;
+        falhas++;
+    }
+    return falhas;
+}
+
+TesteDiferencial::TesteDiferencial(const ConfigDiferencial& config) : config(config) {}
+
+ResultadoDiferencial TesteDiferencial::executar(ostream& log) {
+    ResultadoDiferencial resultado;
+    char linha[256];
+
+    snprintf(linha, sizeof(linha), "%-9s %8s %9s  %-14s %10s %10s %10s %12s  %s\n",
+             "Gerador", "V", "E", "Metodo", "ms", "Mem (kB)", "Alocacoes", "Bytes", "Peso");
+    log << linha;
+
+    for (const auto& gerador : config.geradores) {
+        for (int v = config.verticesMin; v <= config.verticesMax; v *= 2) {
+            if ((gerador == "denso" || gerador == "completo") && v > config.limiteDenso) break;
+
+            GrafoDirecionadoPonderado grafo(0);
+            bool simetrico = false;
+            if (!GeradorGrafos::porNome(gerador, v, config.semente, grafo, simetrico)) {
+                log << "[ERRO] Gerador desconhecido: " << gerador << "\n";
+                resultado.divergencias++;
+                break;
+            }
+
+            const int raiz = 0;
+            bool temReferencia = false;
+            double referencia = 0.0;
+
+            for (int metodo = 0; SeletorMetodo::valido(metodo); ++metodo) {
+                if (metodo == 0 && (double)grafo.numVertices() * grafo.numArcos() > config.limiteEdmonds) continue;
+
+                MedicaoDiferencial m;
+                m.gerador = gerador;
+                m.vertices = grafo.numVertices();
+                m.arestas = grafo.numArcos();
+                m.metodo = metodo;
+
+                // Devolve ao sistema a memória livre das execuções anteriores; sem isso
+                // o alocador reaproveita páginas já residentes e o pico não cresce
+                MedidorMemoria::devolverMemoriaLivre();
+                EspacoTrabalhoArborescencia espaco;
+                long rssAntes = MedidorMemoria::statusKB("VmRSS");
+                bool picoReiniciado = MedidorMemoria::reiniciarPico();
+                long long alocacoesAntes = MedidorMemoria::alocacoes();
+                long long bytesAntes = MedidorMemoria::bytesAlocados();
+
+                auto inicio = chrono::steady_clock::now();
+                GrafoDirecionadoPonderado arvore = SeletorMetodo::resolver(metodo, grafo, raiz, &espaco, config.heap);
+                m.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+
+                long pico = MedidorMemoria::statusKB("VmHWM");
+                if (picoReiniciado && pico >= 0 && rssAntes >= 0) m.memoriaKB = max(0L, pico - rssAntes);
+                if (MedidorMemoria::contandoAlocacoes()) {
+                    m.alocacoes = MedidorMemoria::alocacoes() - alocacoesAntes;
+                    m.bytesAlocados = MedidorMemoria::bytesAlocados() - bytesAntes;
+                }
+                m.peso = somaPesos(arvore);
+
+                // Edmonds e a arvore de contracao nao deixam certificado; o peso
+                // ainda e comparado com o dos outros metodos abaixo
+                if (config.verificar && SeletorMetodo::verificavel(metodo)) {
+                    ResultadoVerificacao ver = SeletorMetodo::verificar(metodo, grafo, raiz, arvore, &espaco);
+                    m.otimo = ver.otimo;
+                    if (!ver.otimo) {
+                        log << "[FALHA] " << gerador << " V=" << m.vertices << " " << SeletorMetodo::nome(metodo)
+                            << ": " << ver.motivo << "\n";
+                        resultado.divergencias++;
+                    }
+                }
+
+                // A MST só é comparável à arborescência quando os pesos são simétricos
+                if (metodo != 1 || simetrico) {
+                    if (!temReferencia) {
+                        referencia = m.peso;
+                        temReferencia = true;
+                    } else if (fabs(m.peso - referencia) > 1e-9 * (1.0 + fabs(referencia))) {
+                        snprintf(linha, sizeof(linha), "[DIVERGENCIA] %s V=%d %s: peso %.9f, esperado %.9f\n",
+                                 gerador.c_str(), m.vertices, SeletorMetodo::nome(metodo), m.peso, referencia);
+                        log << linha;
+                        resultado.divergencias++;
+                    }
+                }
+
+                snprintf(linha, sizeof(linha), "%-9s %8d %9zu  %-14s %10.2f %10ld %10lld %12lld  %.9f\n",
+                         gerador.c_str(), m.vertices, m.arestas, SeletorMetodo::nome(metodo), m.ms, m.memoriaKB,
+                         m.alocacoes, m.bytesAlocados, m.peso);
+                log << linha;
+                log.flush();
+                resultado.medicoes.push_back(m);
+            }
+
+            if (MedidorMemoria::contandoAlocacoes()) {
+                resultado.divergencias += conferirAlocacoes<HeapSkew>(grafo, gerador, PoliticaHeap::SKEW, log)
+                                        + conferirAlocacoes<HeapLeftist>(grafo, gerador, PoliticaHeap::LEFTIST, log)
+                                        + conferirAlocacoes<HeapPairing>(grafo, gerador, PoliticaHeap::PAIRING, log)
+                                        + conferirAlocacoes<HeapRadix>(grafo, gerador, PoliticaHeap::RADIX, log);
+            }
+        }
+    }
+    return resultado;
+}
+
+bool TesteDiferencial::escreverCSV(const string& caminho, const vector<MedicaoDiferencial>& medicoes) {
+    FILE* f = fopen(caminho.c_str(), "w");
+    if (!f) return false;
+
+    bool ok = fprintf(f, "gerador,vertices,arestas,metodo,ms,memoria_kb,alocacoes,bytes_alocados,peso,otimo\n") > 0;
+    for (const auto& m : medicoes) {
+        ok = ok && fprintf(f, "%s,%d,%zu,%s,%.4f,%ld,%lld,%lld,%.9f,%d\n", m.gerador.c_str(), m.vertices,
+                           m.arestas, SeletorMetodo::nome(m.metodo), m.ms, m.memoriaKB, m.alocacoes, m.bytesAlocados,
+                           m.peso, m.otimo ? 1 : 0) > 0;
+    }
+    return fclose(f) == 0 && ok;
+}
@@ -0,0 +1,270 @@
+#include "VerificadorOtimalidade.h"
+#include "UnionFind.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
+using namespace std;
+
+// LCA offline de Tarjan numa floresta em que o pai tem sempre id maior que o
+// filho (hierarquia de contração, árvore de reconstrução de Kruskal).
+// lca[i] = -1 quando os extremos da consulta i estão em árvores diferentes.
+// Retorna false se 'pai' não respeitar a ordem exigida.
+static bool lcaOffline(const vector<int>& pai, const vector<pair<int, int>>& consultas, vector<int>& lca) {
+    const int N = (int)pai.size();
+    const int Q = (int)consultas.size();
+
+    // Raiz de cada árvore, de cima para baixo (pai > filho)
+    vector<int> raizArvore(N);
+    for (int x = N - 1; x >= 0; --x) {
+        if (pai[x] != -1 && (pai[x] <= x || pai[x] >= N)) return false;
+        raizArvore[x] = pai[x] == -1 ? x : raizArvore[pai[x]];
+    }
+
+    // Filhos e consultas de cada nó em CSR
+    vector<int> inicioFilhos(N + 1, 0), inicioConsultas(N + 1, 0);
+    for (int x = 0; x < N; ++x)
+        if (pai[x] != -1) inicioFilhos[pai[x] + 1]++;
+
+    lca.assign(Q, -1);
+    for (int q = 0; q < Q; ++q) {
+        int a = consultas[q].first, b = consultas[q].second;
+        if (raizArvore[a] != raizArvore[b]) continue;
+        if (a == b) { lca[q] = a; continue; }
+        inicioConsultas[a + 1]++;
+        inicioConsultas[b + 1]++;
+    }
+    partial_sum(inicioFilhos.begin(), inicioFilhos.end(), inicioFilhos.begin());
+    partial_sum(inicioConsultas.begin(), inicioConsultas.end(), inicioConsultas.begin());
+
+    vector<int> filhos(inicioFilhos[N]), consultasNo(inicioConsultas[N]);
+    {
+        vector<int> pos(inicioFilhos.begin(), inicioFilhos.end() - 1);
+        for (int x = 0; x < N; ++x)
+            if (pai[x] != -1) filhos[pos[pai[x]]++] = x;
+        pos.assign(inicioConsultas.begin(), inicioConsultas.end() - 1);
+        for (int q = 0; q < Q; ++q) {
+            int a = consultas[q].first, b = consultas[q].second;
+            if (a == b || raizArvore[a] != raizArvore[b]) continue;
+            consultasNo[pos[a]++] = q;
+            consultasNo[pos[b]++] = q;
+        }
+    }
+
+    // DFS iterativa; ao terminar x, responde as consultas cujo outro extremo já terminou
+    UnionFind uf(N);
+    vector<int> ancestral(N), proximoFilho(inicioFilhos.begin(), inicioFilhos.end() - 1);
+    vector<char> terminado(N, 0);
+    vector<int> pilha;
+    for (int r = 0; r < N; ++r) {
+        if (pai[r] != -1) continue;
+        ancestral[r] = r;
+        pilha.push_back(r);
+        while (!pilha.empty()) {
+            int x = pilha.back();
+            if (proximoFilho[x] < inicioFilhos[x + 1]) {
+                int c = filhos[proximoFilho[x]++];
+                ancestral[c] = c;
+                pilha.push_back(c);
+                continue;
+            }
+            pilha.pop_back();
+            terminado[x] = 1;
+            for (int k = inicioConsultas[x]; k < inicioConsultas[x + 1]; ++k) {
+                int q = consultasNo[k];
+                int outro = consultas[q].first == x ? consultas[q].second : consultas[q].first;
+                if (terminado[outro]) lca[q] = ancestral[uf.find(outro)];
+            }
+            if (pai[x] != -1) {
+                uf.unite(pai[x], x);
+                ancestral[uf.find(pai[x])] = pai[x];
+            }
+        }
+    }
+    return true;
+}
+
+static ResultadoVerificacao falha(ResultadoVerificacao r, const string& motivo) {
+    r.otimo = false;
+    r.motivo = motivo;
+    return r;
+}
+
+CertificadoArborescencia VerificadorOtimalidade::certificado(const EspacoTrabalhoArborescencia& espaco) {
+    CertificadoArborescencia cert;
+    int numNos = espaco.numNosHierarquia;
+    cert.pai.assign(espaco.paiNaHierarquia.begin(), espaco.paiNaHierarquia.begin() + numNos);
+    cert.y.assign(numNos, 0.0);
+    for (int x = 0; x < numNos; ++x) {
+        if (espaco.arestaEntradaEscolhida[x] != -1) cert.y[x] = espaco.pesoEntradaEscolhida[x];
+    }
+    return cert;
+}
+
+ResultadoVerificacao VerificadorOtimalidade::verificarArborescencia(const GrafoDirecionadoPonderado& grafo, int raiz,
+                                                                    const vector<Aresta>& arvore,
+                                                                    const CertificadoArborescencia& cert) {
+    ResultadoVerificacao r;
+    const int n = grafo.numVertices();
+    const VisaoArcos arestas = grafo.getArcos();
+
+    double escala = 1.0;
+    for (const auto& a : arvore) {
+        r.pesoArvore += a.peso;
+        escala += fabs(a.peso);
+    }
+    const double tolerancia = 1e-9 * escala;
+
+    // 1. Estrutura: uma aresta de entrada por vértice (exceto a raiz), todas do grafo
+    if (raiz < 0 || raiz >= n) return falha(r, "raiz fora do intervalo");
+    if ((int)arvore.size() != n - 1) return falha(r, "numero de arestas diferente de V-1");
+
+    vector<int> origemEntrada(n, -1);
+    vector<double> pesoEntrada(n, 0.0);
+    for (const auto& a : arvore) {
+        if (a.origem < 0 || a.origem >= n || a.destino < 0 || a.destino >= n)
+            return falha(r, "aresta com extremo invalido");
+        if (a.destino == raiz) return falha(r, "aresta entrando na raiz");
+        if (origemEntrada[a.destino] != -1)
+            return falha(r, "vertice " + to_string(a.destino) + " com duas arestas de entrada");
+        origemEntrada[a.destino] = a.origem;
+        pesoEntrada[a.destino] = a.peso;
+    }
+
+    vector<char> presente(n, 0);
+    presente[raiz] = 1;
+    for (const auto& a : arestas) {
+        if (a.destino != raiz && origemEntrada[a.destino] == a.origem && pesoEntrada[a.destino] == a.peso)
+            presente[a.destino] = 1;
+    }
+    for (int v = 0; v < n; ++v) {
+        if (!presente[v]) return falha(r, "aresta de entrada de " + to_string(v) + " nao pertence ao grafo");
+    }
+
+    // Alcançabilidade a partir da raiz (descarta ciclos soltos)
+    vector<int> inicioFilhos(n + 1, 0), filhos(n - 1);
+    for (const auto& a : arvore) inicioFilhos[a.origem + 1]++;
+    partial_sum(inicioFilhos.begin(), inicioFilhos.end(), inicioFilhos.begin());
+    {
+        vector<int> pos(inicioFilhos.begin(), inicioFilhos.end() - 1);
+        for (const auto& a : arvore) filhos[pos[a.origem]++] = a.destino;
+    }
+    vector<int> fila(1, raiz);
+    fila.reserve(n);
+    for (size_t i = 0; i < fila.size(); ++i) {
+        int u = fila[i];
+        for (int k = inicioFilhos[u]; k < inicioFilhos[u + 1]; ++k) fila.push_back(filhos[k]);
+    }
+    if ((int)fila.size() != n) return falha(r, "vertices inalcancaveis a partir da raiz (ciclo)");
+
+    // 2. Certificado: supernós com y >= 0 e conjuntos que contêm a raiz com y = 0
+    const int N = (int)cert.pai.size();
+    if (N < n || (int)cert.y.size() != N) return falha(r, "certificado incompleto");
+    for (int x = n; x < N; ++x) {
+        if (cert.y[x] < -tolerancia) return falha(r, "superno " + to_string(x) + " com y negativo");
+    }
+
+    // Soma de y de cada nó até o topo da sua árvore (pai > filho: de cima para baixo)
+    vector<double> acumulado(N, 0.0);
+    for (int x = N - 1; x >= 0; --x) {
+        int p = cert.pai[x];
+        if (p != -1 && (p <= x || p >= N)) return falha(r, "hierarquia do certificado invalida");
+        acumulado[x] = cert.y[x] + (p == -1 ? 0.0 : acumulado[p]);
+        r.limiteDual += cert.y[x];
+    }
+    for (int x = raiz; x != -1; x = cert.pai[x]) {
+        if (fabs(cert.y[x]) > tolerancia) return falha(r, "conjunto contendo a raiz com y nao nulo");
+    }
+
+    // 3. Viabilidade dual: y dos conjuntos que contêm v mas não u não excede w(u, v)
+    vector<pair<int, int>> consultas;
+    consultas.reserve(arestas.size());
+    for (const auto& a : arestas) consultas.emplace_back(a.origem, a.destino);
+    vector<int> lca;
+    if (!lcaOffline(cert.pai, consultas, lca)) return falha(r, "hierarquia do certificado invalida");
+
+    for (size_t i = 0; i < arestas.size(); ++i) {
+        const auto& a = arestas[i];
+        if (a.origem == a.destino || a.destino == raiz) continue;
+        double soma = acumulado[a.destino] - (lca[i] == -1 ? 0.0 : acumulado[lca[i]]);
+        if (soma > a.peso + tolerancia) {
+            return falha(r, "restricao dual violada na aresta " + to_string(a.origem) + "->" + to_string(a.destino)
+                            + " (soma y = " + to_string(soma) + " > peso " + to_string(a.peso) + ")");
+        }
+    }
+
+    // 4. Folga complementar: peso da árvore igual ao limite dual
+    if (fabs(r.limiteDual - r.pesoArvore) > tolerancia) {
+        return falha(r, "peso da arvore (" + to_string(r.pesoArvore) + ") acima do limite dual ("
+                        + to_string(r.limiteDual) + ")");
+    }
+
+    r.otimo = true;
+    return r;
+}
+
+ResultadoVerificacao VerificadorOtimalidade::verificarMST(int n, const vector<Aresta>& arestas, const vector<Aresta>& arvore) {
+    ResultadoVerificacao r;
+
+    for (const auto& a : arvore) {
+        if (a.origem < 0 || a.origem >= n || a.destino < 0 || a.destino >= n)
+            return falha(r, "aresta com extremo invalido");
+        r.pesoArvore += a.peso;
+    }
+    r.limiteDual = r.pesoArvore;
+
+    // Arestas da árvore precisam existir no grafo (em qualquer sentido, mesmo peso)
+    auto chave = [n](int u, int v) { return (long long)min(u, v) * n + max(u, v); };
+    unordered_map<long long, int> indiceArvore;
+    indiceArvore.reserve(arvore.size() * 2);
+    for (size_t i = 0; i < arvore.size(); ++i) indiceArvore.emplace(chave(arvore[i].origem, arvore[i].destino), (int)i);
+    vector<char> presente(arvore.size(), 0);
+    for (const auto& a : arestas) {
+        auto it = indiceArvore.find(chave(a.origem, a.destino));
+        if (it != indiceArvore.end() && arvore[it->second].peso == a.peso) presente[it->second] = 1;
+    }
+    for (size_t i = 0; i < arvore.size(); ++i) {
+        if (!presente[i]) return falha(r, "aresta da arvore nao pertence ao grafo");
+    }
+
+    // Árvore de reconstrução de Kruskal: o LCA de u e v guarda o maior peso
+    // no caminho entre eles na floresta
+    vector<int> ordem(arvore.size());
+    iota(ordem.begin(), ordem.end(), 0);
+    sort(ordem.begin(), ordem.end(), [&](int a, int b) { return arvore[a].peso < arvore[b].peso; });
+
+    vector<int> pai(n + arvore.size(), -1), noDoConjunto(n);
+    vector<double> pesoNo(pai.size(), 0.0);
+    iota(noDoConjunto.begin(), noDoConjunto.end(), 0);
+    UnionFind uf(n);
+    int proximo = n;
+    for (int i : ordem) {
+        int a = uf.find(arvore[i].origem), b = uf.find(arvore[i].destino);
+        if (a == b) return falha(r, "arvore contem ciclo");
+        pai[noDoConjunto[a]] = pai[noDoConjunto[b]] = proximo;
+        pesoNo[proximo] = arvore[i].peso;
+        uf.unite(a, b);
+        noDoConjunto[uf.find(a)] = proximo++;
+    }
+
+    // Propriedade do ciclo para cada aresta do grafo
+    vector<pair<int, int>> consultas;
+    consultas.reserve(arestas.size());
+    for (const auto& a : arestas) consultas.emplace_back(a.origem, a.destino);
+    vector<int> lca;
+    lcaOffline(pai, consultas, lca);
+
+    for (size_t i = 0; i < arestas.size(); ++i) {
+        const auto& a = arestas[i];
+        if (a.origem == a.destino) continue;
+        if (lca[i] == -1) return falha(r, "floresta nao e geradora (aresta liga componentes distintos)");
+        if (a.peso < pesoNo[lca[i]]) {
+            return falha(r, "propriedade do ciclo violada na aresta " + to_string(a.origem) + "-" + to_string(a.destino)
+                            + " (peso " + to_string(a.peso) + " < maximo do caminho " + to_string(pesoNo[lca[i]]) + ")");
+        }
+    }
+
+    r.otimo = true;
+    return r;
+}
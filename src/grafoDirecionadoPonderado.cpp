@@ -1,19 +1,79 @@
 #include "grafoDirecionadoPonderado.h"
 #include <iostream>
+#include <stdexcept>
 
-GrafoDirecionadoPonderado::GrafoDirecionadoPonderado(int vertices) 
+static void verificarExtremos(int vertices, int origem, int destino) {
+    if (origem < 0 || origem >= vertices || destino < 0 || destino >= vertices) {
+        throw std::out_of_range("Aresta " + std::to_string(origem) + " -> " + std::to_string(destino)
+                                + " fora dos " + std::to_string(vertices) + " vertices do grafo");
+    }
+}
+
+GrafoDirecionadoPonderado::GrafoDirecionadoPonderado(int vertices)
+    : GrafoDirecionado(vertices) {}
+
+GrafoDirecionadoPonderado::GrafoDirecionadoPonderado(int vertices, std::vector<Aresta>&& arestas)
+    : GrafoDirecionado(vertices), todasArestas(std::move(arestas)) {
+    for (const auto& a : todasArestas) verificarExtremos(V, a.origem, a.destino);
+}
+
+GrafoDirecionadoPonderado::GrafoDirecionadoPonderado(int vertices, const std::vector<int>& origens,
+                                                     const std::vector<int>& destinos, const std::vector<double>& pesos)
     : GrafoDirecionado(vertices) {
-    adjPeso.resize(V);
-    adjEntrada.resize(V);
+    if (destinos.size() != origens.size() || pesos.size() != origens.size()) {
+        throw std::invalid_argument("Vetores de origens, destinos e pesos com tamanhos diferentes");
+    }
+    todasArestas.reserve(origens.size());
+    for (size_t i = 0; i < origens.size(); ++i) {
+        verificarExtremos(V, origens[i], destinos[i]);
+        todasArestas.emplace_back(origens[i], destinos[i], pesos[i]);
+    }
+}
+
+const GrafoDirecionadoPonderado::IndicesAdjacencia& GrafoDirecionadoPonderado::obterIndices() const {
+    IndicesAdjacencia& ind = *indices;
+    std::call_once(ind.montagem, [&] {
+        // Counting sort estável por origem e por destino, numa passada de contagem
+        // e outra de distribuição
+        const VisaoArcos arcos = getArcos();
+        const int m = (int)arcos.size();
+        ind.inicioSaida.assign(V + 1, 0);
+        ind.inicioEntrada.assign(V + 1, 0);
+        for (int i = 0; i < m; ++i) {
+            const Aresta a = arcos[i];
+            ind.inicioSaida[a.origem + 1]++;
+            ind.inicioEntrada[a.destino + 1]++;
+        }
+        for (int v = 0; v < V; ++v) {
+            ind.inicioSaida[v + 1] += ind.inicioSaida[v];
+            ind.inicioEntrada[v + 1] += ind.inicioEntrada[v];
+        }
+
+        ind.posSaida.resize(m);
+        ind.posEntrada.resize(m);
+        std::vector<int> proxSaida(ind.inicioSaida.begin(), ind.inicioSaida.end() - 1);
+        std::vector<int> proxEntrada(ind.inicioEntrada.begin(), ind.inicioEntrada.end() - 1);
+        for (int i = 0; i < m; ++i) {
+            const Aresta a = arcos[i];
+            ind.posSaida[proxSaida[a.origem]++] = i;
+            ind.posEntrada[proxEntrada[a.destino]++] = i;
+        }
+        ind.montados.store(true, std::memory_order_release);
+    });
+    return ind;
+}
+
+void GrafoDirecionadoPonderado::reservarArestas(size_t numArestas) {
+    todasArestas.reserve(numArestas);
 }
 
 void GrafoDirecionadoPonderado::adicionarAresta(int v1, int v2, double peso) {
     if (v1 < V && v2 < V) {
-        adjPeso[v1].emplace_back(v2, peso);
-        
-        Aresta novaAresta(v1, v2, peso);
-        adjEntrada[v2].push_back(novaAresta);
-        todasArestas.push_back(novaAresta);
+        todasArestas.emplace_back(v1, v2, peso);
+        // Índices já montados ou compartilhados com uma cópia não valem mais
+        // para este grafo; sem isso, basta montá-los no próximo acesso
+        if (indices.use_count() > 1 || indices->montados.load(std::memory_order_acquire))
+            indices = std::make_shared<IndicesAdjacencia>();
     }
 }
 
@@ -21,25 +81,36 @@ void GrafoDirecionadoPonderado::imprimirGrafo() const {
     std::cout << "Grafo Direcionado Ponderado (Lista de Adjacencias):\n";
     for (int v = 0; v < V; ++v) {
         std::cout << "Vertice " << v << " -> [ ";
-        for (const auto& par : adjPeso[v]) {
-            int vizinho = par.first;
-            double peso = par.second;
-            std::cout << "(" << vizinho << ", " << peso << ") ";
+        for (const auto& aresta : getArestasSaida(v)) {
+            std::cout << "(" << aresta.destino << ", " << aresta.peso << ") ";
         }
         std::cout << "]\n";
     }
 }
 
-const std::list<Aresta>& GrafoDirecionadoPonderado::getArestasEntrada(int v) const {
-    return adjEntrada[v];
+FaixaArestas GrafoDirecionadoPonderado::getArestasEntrada(int v) const {
+    const IndicesAdjacencia& ind = obterIndices();
+    const int* pos = ind.posEntrada.data();
+    if (!entradaRemovida.empty() && entradaRemovida[v]) {
+        return FaixaArestas(getArcos(), pos, pos);
+    }
+    return FaixaArestas(getArcos(), pos + ind.inicioEntrada[v], pos + ind.inicioEntrada[v + 1]);
+}
+
+FaixaArestas GrafoDirecionadoPonderado::getArestasSaida(int v) const {
+    const IndicesAdjacencia& ind = obterIndices();
+    const int* pos = ind.posSaida.data();
+    return FaixaArestas(getArcos(), pos + ind.inicioSaida[v], pos + ind.inicioSaida[v + 1]);
 }
 
 const std::vector<Aresta>& GrafoDirecionadoPonderado::getTodasArestas() const {
     return todasArestas;
 }
 
+// Esvazia a lista de entrada de v; as arestas continuam em todasArestas
 void GrafoDirecionadoPonderado::removerArestasEntrada(int v) {
     if(v < V) {
-        adjEntrada[v].clear();
+        if (entradaRemovida.empty()) entradaRemovida.assign(V, 0);
+        entradaRemovida[v] = 1;
     }
-}
\ No newline at end of file
+}
@@ -2,18 +2,19 @@
 #include <iostream>
 
 GrafoNaoDirecionadoPonderado::GrafoNaoDirecionadoPonderado(int vertices)
-    : GrafoDirecionadoPonderado(vertices) {}
+    : GrafoDirecionadoPonderado(vertices) {
+    simetrico = true;
+}
+
+GrafoNaoDirecionadoPonderado::GrafoNaoDirecionadoPonderado(int vertices, std::vector<Aresta>&& arestas)
+    : GrafoDirecionadoPonderado(vertices, std::move(arestas)) {
+    simetrico = true;
+}
 
 void GrafoNaoDirecionadoPonderado::adicionarAresta(int v1, int v2, double peso)
 {
-    if (v1 < V && v2 < V)
-    {
-        adjPeso[v1].emplace_back(v2, peso);
-        adjPeso[v2].emplace_back(v1, peso);
-
-        Aresta a(v1, v2, peso);
-        todasArestas.push_back(a);
-    }
+    // Cada aresta é guardada uma vez; os dois sentidos aparecem em getArcos()
+    GrafoDirecionadoPonderado::adicionarAresta(v1, v2, peso);
 }
 
 void GrafoNaoDirecionadoPonderado::imprimirGrafo() const
@@ -22,12 +23,8 @@ void GrafoNaoDirecionadoPonderado::imprimirGrafo() const
     for (int v = 0; v < V; ++v)
     {
         std::cout << "Vertice " << v << " -> [ ";
-        for (const auto &par : adjPeso[v])
-        {
-            int vizinho = par.first;
-            double peso = par.second;
-            std::cout << "(" << vizinho << ", " << peso << ") ";
-        }
+        for (const auto &aresta : getArestasSaida(v))
+            std::cout << "(" << aresta.destino << ", " << aresta.peso << ") ";
         std::cout << "]\n";
     }
-}
\ No newline at end of file
+}
@@ -1,30 +1,599 @@
 #include <iostream>
 #include <chrono>
 #include <stdexcept> 
-#include "AlgoritmoEdmonds.h"
-#include "AlgoritmoKruskal.h"
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <filesystem>
 #include "SegmentadorImagem.h"
-#include "AlgoritmoTarjan.h"
-#include "AlgoritmoGabow.h"
+#include "SeletorMetodo.h"
+#include "ProcessadorLote.h"
+#include "ProcessadorSequencia.h"
+#include "ServidorSegmentacao.h"
+#include "BenchmarkHeaps.h"
+#include "GeradorGrafos.h"
+#include "TesteDiferencial.h"
+#include "LeitorGrafo.h"
+#include "ContadoresDesempenho.h"
+#include "Rastreamento.h"
 
 using namespace std;
 using namespace std::chrono;
 
 void imprimirUso() {
-    cout << "Uso: ./grafo_app <imagem_entrada> <metodo> <limiar>\n";
+    cout << "Uso: ./grafo_app <imagem_entrada> <metodo> <limiar> [opcoes]\n";
+    cout << "     ./grafo_app --lote <diretorio|lista.txt> <diretorio_saida> <trabalhadores> <metodo> <limiar> [opcoes]\n";
+    cout << "     ./grafo_app --sequencia <diretorio|lista.txt> <diretorio_saida> <metodo> <limiar> [--ladrilho N] [--tolerancia D] [--comparar] [opcoes]\n";
+    cout << "     ./grafo_app --grafo <arquivo> <metodo> [--raiz N] [--heap H] [--threads T] [--verificar] [--estatisticas] [--saida arestas.txt]\n";
+    cout << "     ./grafo_app --servidor <socket> [trabalhadores] [--cache <diretorio>]\n";
+    cout << "     ./grafo_app --cliente <socket> <imagem> <metodo> <limiar[,limiar...]> [--repeticoes N] [opcoes]\n";
+    cout << "     ./grafo_app --cliente <socket> sair\n";
+    cout << "     ./grafo_app --bench-heaps <vertices> <grau_entrada> [repeticoes]\n";
+    cout << "     ./grafo_app --diferencial <saida.csv> [vertices_max] [--geradores a,b,...] [--semente N] [--heap H]\n";
     cout << "Metodos: \n";
     cout << "  0: Edmonds (Classico - O(VE))\n";
     cout << "  1: Kruskal (Baseline MST - Nao Direcionado)\n";
     cout << "  2: Tarjan  (Otimizado c/ Skew Heaps)\n";
-    cout << "  3: Gabow   (Adaptado c/ Skew Heaps)\n\n";
+    cout << "  3: Gabow   (Adaptado c/ Skew Heaps)\n";
+    cout << "  4: Arvore de contracao (construida sem raiz, extracao O(V) para qualquer raiz)\n\n";
+    cout << "Opcoes do solver:\n";
+    cout << "  --heap <skew|leftist|pairing|radix>  Heap usada na contracao, metodos 2 a 4 (padrao: skew)\n";
+    cout << "  --raiz <indice|maior>                Raiz da arborescencia; 'maior' = maior superpixel (padrao: 0)\n";
+    cout << "  --verificar                          Verifica a otimalidade do resultado (certificado dual / ciclo), metodos 1 a 3\n";
+    cout << "  --estatisticas                       Contadores do solver (ciclos, heaps, recursao), metodos 0 a 3\n";
+    cout << "  --cache <diretorio>                  Reaproveita o grafo de superpixels entre execucoes\n";
+    cout << "  --ordem <varredura|hilbert|morton>   Numeracao dos superpixels (padrao: varredura)\n";
+    cout << "  --superpixels <K>                    Superpixels por SLIC, cerca de K (padrao: agrupamento por limiar)\n";
+    cout << "  --threads <T>                        Threads do SLIC no modo simples (padrao: todos os nucleos)\n";
+    cout << "  --piramide <niveis>                  Previa: segmenta a imagem reduzida 2^niveis vezes e refina as bordas\n";
+    cout << "  --roi <x,y,largura,altura>           Segmenta so o retangulo; a saida tem o tamanho dele\n";
+    cout << "                                       (a decodificacao ainda le a imagem inteira)\n";
+    cout << "  --perf                               Contadores de hardware por fase (Linux, perf_event_open)\n";
+    cout << "  --memoria                            Pico de RSS e alocacoes por fase (alocacoes: make instrumentado)\n";
+    cout << "  --rastro <arquivo.json>              Linha do tempo Chrome trace (chrome://tracing, Perfetto); todos os modos\n\n";
+    cout << "Opcoes de saida:\n";
+    cout << "  --formato <png|ppm|rotulos>  Formato do arquivo (padrao: png)\n";
+    cout << "  --compressao <0-9>           Nivel de compressao do PNG (0 = sem compressao)\n";
+    cout << "  --saida <arquivo>            Caminho de saida (padrao: saida_<metodo>.<ext>; nao se aplica ao lote)\n\n";
+    cout << "Modo lote: processa todas as imagens do diretorio (ou da lista) em paralelo.\n";
+    cout << "  Use 0 trabalhadores para usar todos os nucleos disponiveis.\n";
+    cout << "  --pipeline                   Executa em estagios ligados por filas limitadas\n\n";
+    cout << "Modo grafo: resolve um arquivo de arestas ('origem destino [peso]', a partir de 0)\n";
+    cout << "  ou DIMACS ('p sp V E' / 'a u v w', a partir de 1) sem passar pela imagem.\n\n";
+    cout << "Modo diferencial: roda todos os metodos em grafos sinteticos (grade, esparso, denso,\n";
+    cout << "  completo, aninhado) com V dobrando ate vertices_max (padrao 16384), exige pesos iguais\n";
+    cout << "  e grava tempo e memoria de cada execucao no CSV.\n\n";
     cout << "Exemplo: ./grafo_app teste.png 0 0.075\n";
 }
 
-int main(int argc, char* argv[]) {
-    srand(time(NULL));
+// Remove '<opcao> <valor>' da lista de argumentos; retorna false se ausente.
+// Usado pelas opcoes do solver, validas nos dois modos.
+bool extrairOpcao(vector<char*>& args, const string& opcao, string& valor) {
+    bool encontrada = false;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (opcao != args[i]) continue;
+        if (i + 1 >= args.size()) {
+            throw runtime_error("Opcao sem valor: " + opcao);
+        }
+        valor = args[i + 1];
+        encontrada = true;
+        args.erase(args.begin() + i, args.begin() + i + 2);
+        --i;
+    }
+    return encontrada;
+}
+
+// Remove a opcao sem valor '<opcao>'; retorna true se presente
+bool extrairFlag(vector<char*>& args, const string& opcao) {
+    bool encontrada = false;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (opcao != args[i]) continue;
+        encontrada = true;
+        args.erase(args.begin() + i);
+        --i;
+    }
+    return encontrada;
+}
+
+// --heap <nome>, --raiz <indice|maior> (raiz -1 = maior superpixel) e --verificar
+void extrairOpcoesSolver(vector<char*>& args, PoliticaHeap& heap, int& raiz, bool& verificar) {
+    if (extrairFlag(args, "--verificar")) verificar = true;
+
+    string valor;
+    if (extrairOpcao(args, "--heap", valor) && !politicaHeapPorNome(valor, heap)) {
+        throw runtime_error("Heap invalida: " + valor);
+    }
+    if (extrairOpcao(args, "--raiz", valor)) {
+        if (valor == "maior") {
+            raiz = -1;
+        } else {
+            try {
+                raiz = stoi(valor);
+            } catch (...) {
+                throw runtime_error("Raiz invalida: " + valor);
+            }
+            if (raiz < 0) throw runtime_error("Raiz invalida: " + valor);
+        }
+    }
+}
+
+// --ordem <varredura|hilbert|morton>: numeracao dos superpixels
+void extrairOrdem(vector<char*>& args, OrdemSupernos& ordem) {
+    string valor;
+    if (extrairOpcao(args, "--ordem", valor) && !ordemSupernosPorNome(valor, ordem)) {
+        throw runtime_error("Ordem invalida: " + valor);
+    }
+}
+
+// --threads <T> (0: todos os nucleos)
+void extrairThreads(vector<char*>& args, int& threads) {
+    string valor;
+    if (extrairOpcao(args, "--threads", valor)) {
+        try {
+            threads = stoi(valor);
+        } catch (...) {
+            throw runtime_error("Numero de threads invalido: " + valor);
+        }
+    }
+}
+
+// --superpixels <K>: SLIC com alvo de K superpixels (0: agrupamento por limiar)
+void extrairSuperpixels(vector<char*>& args, int& alvo) {
+    string valor;
+    if (!extrairOpcao(args, "--superpixels", valor)) return;
+    try {
+        alvo = stoi(valor);
+    } catch (...) {
+        throw runtime_error("Numero de superpixels invalido: " + valor);
+    }
+    if (alvo < 0) throw runtime_error("Numero de superpixels invalido: " + valor);
+}
+
+// --piramide <niveis>: pipeline em escala reduzida 2^niveis, bordas refinadas
+void extrairPiramide(vector<char*>& args, int& niveis) {
+    string valor;
+    if (!extrairOpcao(args, "--piramide", valor)) return;
+    try {
+        niveis = stoi(valor);
+    } catch (...) {
+        throw runtime_error("Niveis de piramide invalidos: " + valor);
+    }
+    if (niveis < 0 || niveis > 8) throw runtime_error("Niveis de piramide invalidos (0 a 8): " + valor);
+}
+
+// --roi x,y,largura,altura: segmenta so o retangulo (coordenadas de pixel)
+void extrairRegiao(vector<char*>& args, RegiaoInteresse& regiao) {
+    string valor;
+    if (!extrairOpcao(args, "--roi", valor)) return;
+    char extra;
+    if (sscanf(valor.c_str(), "%d,%d,%d,%d%c", &regiao.x, &regiao.y, &regiao.largura, &regiao.altura, &extra) != 4
+        || regiao.x < 0 || regiao.y < 0 || regiao.largura <= 0 || regiao.altura <= 0) {
+        throw runtime_error("Regiao de interesse invalida (x,y,largura,altura): " + valor);
+    }
+}
+
+// Contadores da resolucao (--estatisticas)
+void imprimirEstatisticas(const EstatisticasSolver& e) {
+    printf("Estatisticas: %lld ciclos contraidos, aninhamento maximo %d, recursao %d\n",
+           e.ciclosContraidos, e.profundidadeMaxima, e.profundidadeRecursao);
+    printf("  Heaps: %zu nos no pico, %lld fusoes, %lld remocoes; %lld auto-lacos descartados\n",
+           e.picoNosHeap, e.fusoesHeap, e.remocoesHeap, e.lacosDescartados);
+}
+
+// Le as opcoes opcionais apos os argumentos posicionais.
+// caminhoSaida nulo indica que --saida nao e aceito (modo lote).
+void lerOpcoesSaida(int argc, char* argv[], int inicio, OpcoesSaida& opcoes, string* caminhoSaida) {
+    for (int i = inicio; i < argc; ++i) {
+        string opcao = argv[i];
+        if (i + 1 >= argc) {
+            throw runtime_error("Opcao sem valor: " + opcao);
+        }
+        string valor = argv[++i];
+
+        if (opcao == "--formato") {
+            if (!EscritorSaida::formatoPorNome(valor, opcoes.formato))
+                throw runtime_error("Formato de saida invalido: " + valor);
+        } else if (opcao == "--compressao") {
+            try {
+                opcoes.nivelCompressaoPng = stoi(valor);
+            } catch (...) {
+                throw runtime_error("Nivel de compressao invalido: " + valor);
+            }
+            if (opcoes.nivelCompressaoPng < 0 || opcoes.nivelCompressaoPng > 9)
+                throw runtime_error("Nivel de compressao deve estar entre 0 e 9.");
+        } else if (opcao == "--saida" && caminhoSaida) {
+            *caminhoSaida = valor;
+        } else {
+            throw runtime_error("Opcao desconhecida: " + opcao);
+        }
+    }
+}
+
+// Modo lote: ./grafo_app --lote <entrada> <saida> <trabalhadores> <metodo> <limiar> [opcoes]
+int executarLote(int argc, char* argv[]) {
+    if (argc < 7) {
+        imprimirUso();
+        return 1;
+    }
+
+    ConfigLote config;
+    config.entrada = argv[2];
+    config.diretorioSaida = argv[3];
+
+    try {
+        config.trabalhadores = stoi(argv[4]);
+        config.metodo = stoi(argv[5]);
+        config.limiar = stod(argv[6]);
+    } catch (...) {
+        throw runtime_error("Argumentos invalidos. 'trabalhadores' e 'metodo' devem ser inteiros e 'limiar' deve ser numero (double).");
+    }
+    if (config.trabalhadores <= 0) {
+        config.trabalhadores = max(1u, thread::hardware_concurrency());
+    }
+
+    // --pipeline nao tem valor; --heap, --raiz e --verificar valem para o solver; as demais opcoes sao de saida
+    vector<char*> opcoes(argv, argv + 7);
+    for (int i = 7; i < argc; ++i) {
+        if (string(argv[i]) == "--pipeline") config.pipeline = true;
+        else opcoes.push_back(argv[i]);
+    }
+    extrairOpcoesSolver(opcoes, config.heap, config.raiz, config.verificar);
+    extrairOpcao(opcoes, "--cache", config.diretorioCache);
+    extrairOrdem(opcoes, config.ordem);
+    extrairSuperpixels(opcoes, config.superpixels);
+    extrairPiramide(opcoes, config.piramide);
+    extrairRegiao(opcoes, config.regiao);
+    lerOpcoesSaida((int)opcoes.size(), opcoes.data(), 7, config.opcoesSaida, nullptr);
+
+    ProcessadorLote lote(config);
+    ResultadoLote r = lote.executar();
+
+    cout << "\n--- Resumo do Lote ---\n";
+    cout << "Imagens processadas: " << r.processadas << " (falhas: " << r.falhas << ")\n";
+    cout << "Tempo total: " << r.segundos << " s\n";
+    if (r.segundos > 0) {
+        cout << "Vazao: " << r.processadas / r.segundos << " imagens/s, "
+             << r.megapixels / r.segundos << " megapixels/s\n";
+    }
+
+    if (!r.estagios.empty()) {
+        cout << "\nEstagio               Threads  Utilizacao  Fila (max/media/cap)\n";
+        for (const auto& e : r.estagios) {
+            printf("%-22s %7d  %9.1f%%  ", e.nome.c_str(), e.threads, 100.0 * e.utilizacao);
+            if (e.capacidadeFila > 0)
+                printf("%zu / %.2f / %zu\n", e.filaMaxima, e.filaMedia, e.capacidadeFila);
+            else
+                printf("-\n");
+        }
+    }
+
+    return r.falhas == 0 ? 0 : 1;
+}
+
+// Quadros de video: ./grafo_app --sequencia <entrada> <saida> <metodo> <limiar> [opcoes]
+int executarSequencia(int argc, char* argv[]) {
+    if (argc < 6) {
+        imprimirUso();
+        return 1;
+    }
+
+    ConfigSequencia config;
+    config.entrada = argv[2];
+    config.diretorioSaida = argv[3];
+
+    try {
+        config.metodo = stoi(argv[4]);
+        config.limiar = stod(argv[5]);
+    } catch (...) {
+        throw runtime_error("Argumentos invalidos. 'metodo' deve ser inteiro e 'limiar' deve ser numero (double).");
+    }
+
+    vector<char*> opcoes(argv, argv + argc);
+    extrairOpcoesSolver(opcoes, config.heap, config.raiz, config.verificar);
+    config.comparar = extrairFlag(opcoes, "--comparar");
+    string valor;
+    try {
+        if (extrairOpcao(opcoes, "--ladrilho", valor)) config.ladrilho = stoi(valor);
+        if (extrairOpcao(opcoes, "--tolerancia", valor)) config.tolerancia = stoi(valor);
+    } catch (...) {
+        throw runtime_error("Valor invalido para --ladrilho ou --tolerancia: " + valor);
+    }
+    extrairPiramide(opcoes, config.piramide);
+    extrairRegiao(opcoes, config.regiao);
+    lerOpcoesSaida((int)opcoes.size(), opcoes.data(), 6, config.opcoesSaida, nullptr);
+
+    ProcessadorSequencia sequencia(config);
+    vector<QuadroSequencia> quadros = sequencia.executar();
+
+    cout << "Quadro  Alterados  Reagrupados  Supernos (mantidos)  Incremental ms  Completo ms          Peso  Peso completo\n";
+    int falhas = 0, incrementais = 0;
+    double somaIncremental = 0.0, somaCompleto = 0.0;
+    for (size_t i = 0; i < quadros.size(); ++i) {
+        const QuadroSequencia& q = quadros[i];
+        if (!q.ok) {
+            printf("%6zu  falhou: %s\n", i, q.caminho.c_str());
+            falhas++;
+            continue;
+        }
+        printf("%6zu  %8.1f%%  %10.1f%%  %8d (%8d)  %14.2f  ", i, 100.0 * q.fracaoAlterada, 100.0 * q.fracaoReagrupada,
+               q.supernos, q.supernosMantidos, q.msIncremental);
+        if (q.msCompleto >= 0) printf("%11.2f  %12.6f  %13.6f\n", q.msCompleto, q.peso, q.pesoCompleto);
+        else printf("%11s  %12.6f  %13s\n", "-", q.peso, "-");
+        if (!q.completo) {
+            incrementais++;
+            somaIncremental += q.msIncremental;
+            somaCompleto += q.msCompleto;
+        }
+    }
+    if (incrementais > 0) {
+        printf("\nMedia dos %d quadros incrementais: %.2f ms", incrementais, somaIncremental / incrementais);
+        if (config.comparar) printf(" (do zero: %.2f ms)", somaCompleto / incrementais);
+        printf("\n");
+    }
+    return falhas == 0 ? 0 : 1;
+}
+
+// Servidor: ./grafo_app --servidor <socket> [trabalhadores] [--cache <diretorio>]
+int executarServidor(int argc, char* argv[]) {
+    if (argc < 3) {
+        imprimirUso();
+        return 1;
+    }
+
+    vector<char*> args(argv, argv + argc);
+    ConfigServidor config;
+    config.caminhoSocket = argv[2];
+    extrairOpcao(args, "--cache", config.diretorioCache);
+    if (args.size() > 4) throw runtime_error(string("Opcao desconhecida: ") + args[4]);
+    if (args.size() == 4) {
+        try {
+            config.trabalhadores = stoi(args[3]);
+        } catch (...) {
+            throw runtime_error("Numero de trabalhadores invalido: " + string(args[3]));
+        }
+    }
+    if (config.trabalhadores <= 0) config.trabalhadores = max(1u, thread::hardware_concurrency());
+
+    ServidorSegmentacao servidor(config);
+    int atendidas = servidor.executar();
+    cout << "Servidor encerrado apos " << atendidas << " requisicoes.\n";
+    return 0;
+}
 
+// Cliente de teste: ./grafo_app --cliente <socket> <imagem> <metodo> <limiares> [opcoes]
+// As opcoes viram campos da requisicao sem validacao local (o servidor responde o erro)
+int executarCliente(int argc, char* argv[]) {
+    if (argc == 4 && string(argv[3]) == "sair") {
+        cout << ServidorSegmentacao::enviar(argv[2], {"sair"})[0] << "\n";
+        return 0;
+    }
+    if (argc < 6) {
+        imprimirUso();
+        return 1;
+    }
+
+    vector<char*> args(argv, argv + argc);
+    int repeticoes = 1;
+    string valor;
+    if (extrairOpcao(args, "--repeticoes", valor)) {
+        try {
+            repeticoes = stoi(valor);
+        } catch (...) {
+            throw runtime_error("Numero de repeticoes invalido: " + valor);
+        }
+        if (repeticoes < 1) throw runtime_error("Numero de repeticoes invalido: " + valor);
+    }
+
+    string saida = string("saida_") + (SeletorMetodo::valido(atoi(argv[4])) ? SeletorMetodo::nome(atoi(argv[4])) : "servidor") + ".png";
+    string requisicao = string("imagem=") + filesystem::absolute(argv[3]).string() + "\tmetodo=" + argv[4] + "\tlimiar=" + argv[5];
+    if (extrairFlag(args, "--verificar")) requisicao += "\tverificar=1";
+    for (const char* campo : {"formato", "compressao", "raiz", "heap", "saida"}) {
+        if (!extrairOpcao(args, string("--") + campo, valor)) continue;
+        if (string(campo) == "saida") saida = valor;
+        else requisicao += string("\t") + campo + "=" + valor;
+    }
+    if (args.size() > 6) throw runtime_error(string("Opcao desconhecida: ") + args[6]);
+    requisicao += "\tsaida=" + filesystem::absolute(saida).string();
+
+    vector<string> respostas = ServidorSegmentacao::enviar(argv[2], vector<string>(repeticoes, requisicao));
+    for (const string& r : respostas) cout << r << "\n";
+    return respostas.back().compare(0, 2, "ok") == 0 ? 0 : 1;
+}
+
+// Microbenchmark das politicas de heap: ./grafo_app --bench-heaps <vertices> <grau> [repeticoes]
+int executarBenchHeaps(int argc, char* argv[]) {
+    if (argc < 4) {
+        imprimirUso();
+        return 1;
+    }
+
+    int vertices, grau, repeticoes = 3;
+    try {
+        vertices = stoi(argv[2]);
+        grau = stoi(argv[3]);
+        if (argc >= 5) repeticoes = stoi(argv[4]);
+    } catch (...) {
+        throw runtime_error("Argumentos invalidos. 'vertices', 'grau_entrada' e 'repeticoes' devem ser inteiros.");
+    }
+    if (vertices < 2 || grau < 1) {
+        throw runtime_error("Use ao menos 2 vertices e grau de entrada 1.");
+    }
+
+    GrafoDirecionadoPonderado grafo = GeradorGrafos::aleatorio(vertices, grau, 42);
+    cout << "Grafo aleatorio: V=" << grafo.numVertices() << " E=" << grafo.numArcos()
+         << " (melhor de " << repeticoes << ", ms)\n\n";
+
+    cout << "Heap      Construcao   Remocoes    Fusoes    Tarjan     Gabow   Peso (Tarjan/Gabow)\n";
+    for (const auto& r : BenchmarkHeaps::executar(grafo, repeticoes)) {
+        printf("%-8s %10.2f %10.2f %9.2f %9.2f %9.2f   %.9f / %.9f\n", nomePoliticaHeap(r.politica),
+               r.construcao, r.remocoes, r.fusoes, r.tarjan, r.gabow, r.pesoTarjan, r.pesoGabow);
+    }
+    return 0;
+}
+
+// Grafo de arquivo: ./grafo_app --grafo <arquivo> <metodo> [opcoes]
+int executarGrafo(int argc, char* argv[]) {
+    if (argc < 4) {
+        imprimirUso();
+        return 1;
+    }
+
+    int metodo;
+    try {
+        metodo = stoi(argv[3]);
+    } catch (...) {
+        throw runtime_error("Argumentos invalidos. 'metodo' deve ser inteiro.");
+    }
+    if (!SeletorMetodo::valido(metodo)) {
+        throw runtime_error("Metodo invalido. Escolha um metodo de 0 a 4.");
+    }
+
+    vector<char*> args(argv, argv + argc);
+    PoliticaHeap heap = PoliticaHeap::SKEW;
+    int raiz = 0;
+    bool verificar = false;
+    extrairOpcoesSolver(args, heap, raiz, verificar);
+    if (verificar) SeletorMetodo::exigirVerificavel(metodo);
+    bool comEstatisticas = extrairFlag(args, "--estatisticas");
+    if (raiz < 0) throw runtime_error("--raiz maior so vale para imagens.");
+
+    string caminhoSaida;
+    int threads = 0;
+    extrairThreads(args, threads);
+    extrairOpcao(args, "--saida", caminhoSaida);
+    if (args.size() > 4) throw runtime_error(string("Opcao desconhecida: ") + args[4]);
+
+    auto start = high_resolution_clock::now();
+    GrafoDirecionadoPonderado grafo = LeitorGrafo::carregar(argv[2], threads);
+    auto stop = high_resolution_clock::now();
+    cout << "Grafo carregado em: " << duration_cast<milliseconds>(stop - start).count() << "ms (V="
+         << grafo.numVertices() << ", E=" << grafo.numArcos() << ")\n";
+
+    cout << "--- Executando " << SeletorMetodo::descricao(metodo) << " (raiz " << raiz << ") ---\n";
+    EspacoTrabalhoArborescencia espaco;
+    EstatisticasSolver estatisticas;
+    start = high_resolution_clock::now();
+    GrafoDirecionadoPonderado resultado = SeletorMetodo::resolver(metodo, grafo, raiz, &espaco, heap,
+                                                                  comEstatisticas ? &estatisticas : nullptr);
+    stop = high_resolution_clock::now();
+    cout << "Metodo concluido em: " << duration_cast<milliseconds>(stop - start).count() << "ms\n";
+    if (comEstatisticas) imprimirEstatisticas(estatisticas);
+
+    double peso = 0.0;
+    for (const auto& a : resultado.getTodasArestas()) peso += a.peso;
+    printf("Arestas: %zu (de %d), peso total: %.9f\n", resultado.getTodasArestas().size(),
+           max(0, grafo.numVertices() - 1), peso);
+
+    if (verificar) {
+        start = high_resolution_clock::now();
+        ResultadoVerificacao v = SeletorMetodo::verificar(metodo, grafo, raiz, resultado, &espaco);
+        stop = high_resolution_clock::now();
+        printf("Verificacao: %s (peso %.9f, limite %.9f) em %lldms\n", v.otimo ? "OTIMO" : "FALHOU",
+               v.pesoArvore, v.limiteDual, (long long)duration_cast<milliseconds>(stop - start).count());
+        if (!v.otimo) throw runtime_error("Resultado nao e otimo: " + v.motivo);
+    }
+
+    // Saida no mesmo formato de lista de arestas, para ser relida com --grafo
+    if (!caminhoSaida.empty()) {
+        FILE* f = fopen(caminhoSaida.c_str(), "w");
+        if (!f) throw runtime_error("Nao foi possivel escrever: " + caminhoSaida);
+        bool ok = true;
+        for (const auto& a : resultado.getTodasArestas())
+            ok = ok && fprintf(f, "%d %d %.17g\n", a.origem, a.destino, a.peso) > 0;
+        if (fclose(f) != 0 || !ok) throw runtime_error("Falha ao escrever: " + caminhoSaida);
+        cout << "Arestas salvas em: " << caminhoSaida << "\n";
+    }
+    return 0;
+}
+
+// Teste diferencial: ./grafo_app --diferencial <saida.csv> [vertices_max] [opcoes]
+int executarDiferencial(int argc, char* argv[]) {
+    if (argc < 3) {
+        imprimirUso();
+        return 1;
+    }
+
+    ConfigDiferencial config;
+    vector<char*> args(argv, argv + argc);
+    string valor;
+    if (extrairOpcao(args, "--heap", valor) && !politicaHeapPorNome(valor, config.heap)) {
+        throw runtime_error("Heap invalida: " + valor);
+    }
+    if (extrairOpcao(args, "--geradores", valor)) {
+        config.geradores.clear();
+        size_t inicio = 0;
+        while (inicio <= valor.size()) {
+            size_t fim = valor.find(',', inicio);
+            if (fim == string::npos) fim = valor.size();
+            if (fim > inicio) config.geradores.push_back(valor.substr(inicio, fim - inicio));
+            inicio = fim + 1;
+        }
+    }
+    try {
+        if (extrairOpcao(args, "--semente", valor)) config.semente = (unsigned)stoul(valor);
+        if (args.size() >= 4) config.verticesMax = stoi(args[3]);
+    } catch (...) {
+        throw runtime_error("Argumentos invalidos. 'vertices_max' e 'semente' devem ser inteiros.");
+    }
+    if (args.size() > 4) throw runtime_error(string("Opcao desconhecida: ") + args[4]);
+    config.verticesMin = min(config.verticesMin, config.verticesMax);
+
+    TesteDiferencial teste(config);
+    ResultadoDiferencial r = teste.executar(cout);
+
+    if (!TesteDiferencial::escreverCSV(args[2], r.medicoes)) {
+        throw runtime_error(string("Nao foi possivel escrever: ") + args[2]);
+    }
+    cout << "\n" << r.medicoes.size() << " execucoes, " << r.divergencias << " divergencias. CSV: " << args[2] << "\n";
+    return r.divergencias == 0 ? 0 : 1;
+}
+
+// Grava o rastro (--rastro) ao sair de main, qualquer que seja o modo ou erro;
+// nesse ponto as threads do lote já terminaram
+struct GravacaoRastro {
+    string caminho;
+    ~GravacaoRastro() {
+        if (caminho.empty()) return;
+        if (Rastreamento::salvar(caminho)) cout << "Rastro salvo em: " << caminho << "\n";
+        else cerr << "Aviso: nao foi possivel gravar o rastro " << caminho << endl;
+    }
+};
+
+int main(int argc, char* argv[]) {
     // Try Catch
     try {
+        // --rastro vale em todos os modos: é retirado antes do despacho
+        vector<char*> argumentos(argv, argv + argc);
+        GravacaoRastro rastro;
+        if (extrairOpcao(argumentos, "--rastro", rastro.caminho)) {
+            Rastreamento::iniciar();
+            Rastreamento::nomearThread("principal");
+        }
+        argc = (int)argumentos.size();
+        argv = argumentos.data();
+
+        if (argc >= 2 && string(argv[1]) == "--lote") {
+            return executarLote(argc, argv);
+        }
+        if (argc >= 2 && string(argv[1]) == "--sequencia") {
+            return executarSequencia(argc, argv);
+        }
+        if (argc >= 2 && string(argv[1]) == "--servidor") {
+            return executarServidor(argc, argv);
+        }
+        if (argc >= 2 && string(argv[1]) == "--cliente") {
+            return executarCliente(argc, argv);
+        }
+        if (argc >= 2 && string(argv[1]) == "--bench-heaps") {
+            return executarBenchHeaps(argc, argv);
+        }
+        if (argc >= 2 && string(argv[1]) == "--grafo") {
+            return executarGrafo(argc, argv);
+        }
+        if (argc >= 2 && string(argv[1]) == "--diferencial") {
+            return executarDiferencial(argc, argv);
+        }
+
         // Validação de quantidade de argumentos
         if (argc < 4) {
             imprimirUso();
@@ -43,79 +612,109 @@ int main(int argc, char* argv[]) {
             throw runtime_error("Argumentos invalidos. 'metodo' deve ser inteiro e 'limiar' deve ser numero (double).");
         }
 
+        if (!SeletorMetodo::valido(metodo)) {
+            throw runtime_error("Metodo invalido. Escolha um metodo de 0 a 4.");
+        }
+
+        vector<char*> opcoes(argv, argv + argc);
+        PoliticaHeap heap = PoliticaHeap::SKEW;
+        int raiz = 0;
+        bool verificar = false;
+        extrairOpcoesSolver(opcoes, heap, raiz, verificar);
+        if (verificar) SeletorMetodo::exigirVerificavel(metodo);
+        bool comEstatisticas = extrairFlag(opcoes, "--estatisticas");
+        bool comPerf = extrairFlag(opcoes, "--perf");
+        bool comMemoria = extrairFlag(opcoes, "--memoria");
+        string diretorioCache;
+        extrairOpcao(opcoes, "--cache", diretorioCache);
+        OrdemSupernos ordem = OrdemSupernos::VARREDURA;
+        extrairOrdem(opcoes, ordem);
+        int superpixels = 0, threadsSLIC = 0;
+        extrairSuperpixels(opcoes, superpixels);
+        extrairThreads(opcoes, threadsSLIC);
+        int niveisPiramide = 0;
+        extrairPiramide(opcoes, niveisPiramide);
+        RegiaoInteresse regiao;
+        extrairRegiao(opcoes, regiao);
+
+        OpcoesSaida opcoesSaida;
+        string caminhoSaida;
+        lerOpcoesSaida((int)opcoes.size(), opcoes.data(), 4, opcoesSaida, &caminhoSaida);
+
+        if (caminhoSaida.empty()) {
+            caminhoSaida = string("saida_") + SeletorMetodo::nome(metodo) + "." + EscritorSaida::extensao(opcoesSaida.formato);
+        }
+
         SegmentadorImagem seg;
-        
+        seg.setOrdemSupernos(ordem);
+        seg.setSuperpixelsAlvo(superpixels);
+        seg.setThreadsSLIC(threadsSLIC);
+        seg.setNiveisPiramide(niveisPiramide);
+        seg.setRegiaoInteresse(regiao);
+        if (!diretorioCache.empty()) {
+            filesystem::create_directories(diretorioCache);
+            seg.setDiretorioCache(diretorioCache);
+        }
+
+        // Com --perf ou --memoria cada fase abaixo é medida; desligado, as chamadas não fazem nada
+        ContadoresDesempenho perf(comPerf, comMemoria);
+
         // Carregamento da imagem
-        if (!seg.carregarImagem(inputPath)) {
+        perf.iniciarFase("carregarImagem");
+        bool carregada = seg.carregarImagem(inputPath);
+        perf.encerrarFase();
+        if (!carregada) {
             throw runtime_error("Nao foi possivel carregar a imagem: " + inputPath);
         }
 
         // 3. Pré-processamento
         cout << "Aplicando suavizacao (blur) para reduzir ruido...\n";
+        perf.iniciarFase("aplicarSuavizacao");
         seg.aplicarSuavizacao();
+        perf.encerrarFase();
 
         // Medir tempo de criação do grafo
         cout << "Criando Grafo de Superpixels...\n";
         auto start = high_resolution_clock::now();
-        GrafoDirecionadoPonderado grafoDir = seg.criarGrafo(); 
+        perf.iniciarFase("criarGrafo");
+        GrafoNaoDirecionadoPonderado grafo = seg.criarGrafo();
+        perf.encerrarFase();
         auto stop = high_resolution_clock::now();
         cout << "Grafo criado em: " << duration_cast<milliseconds>(stop - start).count() << "ms\n";
 
-        GrafoDirecionadoPonderado resultado(0); // Placeholder
+        // 4. Execução do método escolhido
+        raiz = seg.supernoRaiz(raiz);
+        cout << "--- Executando " << SeletorMetodo::descricao(metodo) << " (raiz " << raiz << ") ---\n";
+        start = high_resolution_clock::now();
+        EspacoTrabalhoArborescencia espaco;
+        EstatisticasSolver estatisticas;
+        perf.iniciarFase(string("resolver:") + SeletorMetodo::nome(metodo));
+        GrafoDirecionadoPonderado resultado = SeletorMetodo::resolver(metodo, grafo, raiz, &espaco, heap,
+                                                                      comEstatisticas ? &estatisticas : nullptr);
+        perf.encerrarFase();
+        stop = high_resolution_clock::now();
+        cout << "Metodo concluido em: " << duration_cast<milliseconds>(stop - start).count() << "ms\n";
+        if (comEstatisticas) imprimirEstatisticas(estatisticas);
 
-        // 4. Seleção do Método
-        if (metodo == 0) {
-            cout << "--- Executando Edmonds (Direcionado) ---\n";
-            AlgoritmoEdmonds edmonds;
-            
+        if (verificar) {
             start = high_resolution_clock::now();
-            resultado = edmonds.encontrarArborescenciaMinima(grafoDir, 0);
+            perf.iniciarFase("verificar");
+            ResultadoVerificacao v = SeletorMetodo::verificar(metodo, grafo, raiz, resultado, &espaco);
+            perf.encerrarFase();
             stop = high_resolution_clock::now();
-            
-            cout << "Edmonds concluido em: " << duration_cast<milliseconds>(stop - start).count() << "ms\n";
-            seg.salvarSegmentacao(resultado, "saida_edmonds.png", limiar);
-        } 
-        else if(metodo == 1) {
-            cout << "--- Executando Kruskal (Nao-Direcionado) ---\n";
-            // Conversão para não direcionado
-            GrafoNaoDirecionadoPonderado grafoNaoDir(grafoDir.numVertices());
-            for(const auto& a : grafoDir.getTodasArestas()) {
-                if(a.origem < a.destino) 
-                     grafoNaoDir.adicionarAresta(a.origem, a.destino, a.peso);
-            }
+            printf("Verificacao: %s (peso %.9f, limite %.9f) em %lldms\n", v.otimo ? "OTIMO" : "FALHOU",
+                   v.pesoArvore, v.limiteDual, (long long)duration_cast<milliseconds>(stop - start).count());
+            if (!v.otimo) throw runtime_error("Resultado nao e otimo: " + v.motivo);
+        }
 
-            AlgoritmoKruskal kruskal;
-            
-            start = high_resolution_clock::now();
-            GrafoNaoDirecionadoPonderado mst = kruskal.encontrarMST(grafoNaoDir);
-            stop = high_resolution_clock::now();
-            
-            cout << "Kruskal concluido em: " << duration_cast<milliseconds>(stop - start).count() << "ms\n";
-            
-            // Salvar (Cast implícito funciona pois herda de GrafoDirecionado)
-            seg.salvarSegmentacao(mst, "saida_kruskal.png", limiar);
-
-        } else if (metodo == 2) {
-            cout << "--- Executando Tarjan (Otimizado c/ Skew Heaps) ---\n";
-            AlgoritmoTarjan tarjan;
-            
-            start = high_resolution_clock::now();
-            resultado = tarjan.encontrarArborescenciaMinima(grafoDir, 0);
-            stop = high_resolution_clock::now();
-            
-            cout << "Tarjan concluido em: " << duration_cast<milliseconds>(stop - start).count() << "ms\n";
-            seg.salvarSegmentacao(resultado, "saida_tarjan.png", limiar);
-        } else if (metodo == 3) { // Novo código para Gabow
-            cout << "--- Executando Gabow Modificado (c/ Skew Heaps) ---\n";
-            AlgoritmoGabow gabow;
-            start = high_resolution_clock::now();
-            resultado = gabow.encontrarArborescenciaMinima(grafoDir, 0);
-            stop = high_resolution_clock::now();
-            cout << "Gabow concluido em: " << duration_cast<milliseconds>(stop - start).count() << "ms\n";
-            seg.salvarSegmentacao(resultado, "saida_gabow.png", limiar);
-        } else {
-            throw runtime_error("Metodo invalido. Escolha 0, 1, ou 3.");
-        } 
+        perf.iniciarFase("salvarSegmentacao");
+        if (!seg.salvarSegmentacao(resultado, caminhoSaida, limiar, opcoesSaida))
+            throw runtime_error("Erro ao escrever saida: " + caminhoSaida);
+        perf.encerrarFase();
+
+        if (comPerf || comMemoria) {
+            perf.imprimir(cout, (size_t)seg.getLargura() * seg.getAltura(), grafo.numArcos());
+        }
 
     } catch (const std::exception& e) {
         // Captura qualquer erro lançado acima e imprime de forma limpa
@@ -124,4 +723,4 @@ int main(int argc, char* argv[]) {
     }
 
     return 0;
-}
\ No newline at end of file
+}